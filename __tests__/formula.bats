@@ -44,7 +44,7 @@ fee=4
   run cleos push action curve.sx calculate "[10000000, 4000000000000000000, 4000000000000000000, 2, $fee]" -p curve.sx
   echo "Output: $output"
   [ $status -eq 1 ]
-  [[ "$output" =~ "d1 overflow" ]]
+  [[ "$output" =~ "9996000" ]]
 }
 
 @test "curve formula #7" {
@@ -53,3 +53,24 @@ fee=4
   [ $status -eq 1 ]
   [[ "$output" =~ "invalid reserves" ]]
 }
+
+@test "curve formula #8" {
+  run cleos push action curve.sx calculate "[5564108240870, 2857376198546, 5603821613576, 884, $fee]" -p curve.sx
+  echo "Output: $output"
+  [ $status -eq 1 ]
+  [[ "$output" =~ "5482150499488" ]]
+}
+
+@test "curve formula #9" {
+  run cleos push action curve.sx calculate "[1000000000000000000, 1000000000000000000, 4611686018427387000, $amplifier, $fee]" -p curve.sx
+  echo "Output: $output"
+  [ $status -eq 1 ]
+  [[ "$output" =~ "1003430807411377620" ]]
+}
+
+@test "curve formula #10" {
+  run cleos push action curve.sx calculate "[5889684945, 85692935855, 10607069950, 22, $fee]" -p curve.sx
+  echo "Output: $output"
+  [ $status -eq 1 ]
+  [[ "$output" =~ "3683332307" ]]
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+// slow arbitrary precision integer, exact reference for `__tests__/native/fuzz.cpp`
+// schoolbook multiplication & bitwise long division, no overflow anywhere
+
+#include <eosio/check.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fuzz {
+
+    class bigint {
+    public:
+        bigint() = default;
+        bigint( const int128_t value ) : _negative( value < 0 )
+        {
+            uint128_t magnitude = value < 0 ? -static_cast<uint128_t>( value ) : static_cast<uint128_t>( value );
+            for ( ; magnitude; magnitude >>= 32 ) _limbs.push_back( static_cast<uint32_t>( magnitude ) );
+        }
+        static bigint from_unsigned( uint128_t value )
+        {
+            bigint result;
+            for ( ; value; value >>= 32 ) result._limbs.push_back( static_cast<uint32_t>( value ) );
+            return result;
+        }
+        bigint( const int64_t value ) : bigint( static_cast<int128_t>( value ) ) {}
+        bigint( const uint64_t value ) : bigint( static_cast<int128_t>( value ) ) {}
+        bigint( const int value ) : bigint( static_cast<int128_t>( value ) ) {}
+
+        bool is_negative() const { return _negative; }
+        bool is_zero() const { return _limbs.empty(); }
+
+        // bit length of the magnitude
+        size_t bits() const
+        {
+            if ( _limbs.empty() ) return 0;
+            size_t n = 32 * ( _limbs.size() - 1 );
+            for ( uint32_t top = _limbs.back(); top; top >>= 1 ) ++n;
+            return n;
+        }
+
+        bool fits_uint64() const { return !_negative && bits() <= 64; }
+        bool fits_int64() const { return _negative ? -*this <= bigint( INT64_MAX ) + 1 : bits() <= 63; }
+
+        uint128_t to_uint128() const
+        {
+            uint128_t value = 0;
+            for ( size_t i = std::min<size_t>( _limbs.size(), 4 ); i-- > 0; ) value = ( value << 32 ) | _limbs[i];
+            return value;
+        }
+        int128_t to_int128() const
+        {
+            const int128_t magnitude = static_cast<int128_t>( to_uint128() );
+            return _negative ? -magnitude : magnitude;
+        }
+
+        std::string to_string() const
+        {
+            if ( is_zero() ) return "0";
+            std::string digits;
+            bigint value = abs();
+            const bigint ten = 10;
+            while ( !value.is_zero() ) {
+                const auto [ q, r ] = divmod( value, ten );
+                digits.push_back( '0' + static_cast<char>( r.to_uint128() ) );
+                value = q;
+            }
+            if ( _negative ) digits.push_back( '-' );
+            std::reverse( digits.begin(), digits.end() );
+            return digits;
+        }
+
+        bigint abs() const { bigint r = *this; r._negative = false; return r; }
+        bigint operator-() const { bigint r = *this; if ( !r.is_zero() ) r._negative = !r._negative; return r; }
+
+        friend bigint operator+( const bigint& a, const bigint& b )
+        {
+            if ( a._negative == b._negative ) return make( add( a._limbs, b._limbs ), a._negative );
+            if ( compare_abs( a._limbs, b._limbs ) >= 0 ) return make( sub( a._limbs, b._limbs ), a._negative );
+            return make( sub( b._limbs, a._limbs ), b._negative );
+        }
+        friend bigint operator-( const bigint& a, const bigint& b ) { return a + -b; }
+        friend bigint operator*( const bigint& a, const bigint& b ) { return make( mul( a._limbs, b._limbs ), a._negative != b._negative ); }
+
+        // floor division of non-negative operands
+        friend bigint operator/( const bigint& a, const bigint& b ) { return divmod( a, b ).first; }
+        friend bigint operator%( const bigint& a, const bigint& b ) { return divmod( a, b ).second; }
+
+        friend bool operator==( const bigint& a, const bigint& b ) { return a._negative == b._negative && a._limbs == b._limbs; }
+        friend bool operator!=( const bigint& a, const bigint& b ) { return !( a == b ); }
+        friend bool operator<( const bigint& a, const bigint& b )
+        {
+            if ( a._negative != b._negative ) return a._negative;
+            const int c = compare_abs( a._limbs, b._limbs );
+            return a._negative ? c > 0 : c < 0;
+        }
+        friend bool operator>( const bigint& a, const bigint& b ) { return b < a; }
+        friend bool operator<=( const bigint& a, const bigint& b ) { return !( b < a ); }
+        friend bool operator>=( const bigint& a, const bigint& b ) { return !( a < b ); }
+
+        static std::pair<bigint, bigint> divmod( const bigint& a, const bigint& b )
+        {
+            eosio::check( !a._negative && !b._negative && !b.is_zero(), "bigint: invalid division" );
+            std::vector<uint32_t> q( a._limbs.size() ), r;
+            for ( size_t bit = a.bits(); bit-- > 0; ) {
+                // r = r * 2 + bit
+                uint32_t carry = ( a._limbs[ bit / 32 ] >> ( bit % 32 ) ) & 1;
+                for ( uint32_t& limb : r ) {
+                    const uint32_t next = limb >> 31;
+                    limb = ( limb << 1 ) | carry;
+                    carry = next;
+                }
+                if ( carry ) r.push_back( carry );
+                if ( compare_abs( r, b._limbs ) >= 0 ) {
+                    r = sub( r, b._limbs );
+                    q[ bit / 32 ] |= uint32_t(1) << ( bit % 32 );
+                }
+            }
+            return { make( q, false ), make( r, false ) };
+        }
+
+    private:
+        bool _negative = false;
+        std::vector<uint32_t> _limbs; // little endian, no leading zero limbs
+
+        static bigint make( std::vector<uint32_t> limbs, const bool negative )
+        {
+            while ( !limbs.empty() && limbs.back() == 0 ) limbs.pop_back();
+            bigint result;
+            result._limbs = std::move( limbs );
+            result._negative = negative && !result._limbs.empty();
+            return result;
+        }
+
+        static int compare_abs( const std::vector<uint32_t>& a, std::vector<uint32_t> b )
+        {
+            while ( !b.empty() && b.back() == 0 ) b.pop_back();
+            size_t n = a.size();
+            while ( n > 0 && a[n - 1] == 0 ) --n;
+            if ( n != b.size() ) return n < b.size() ? -1 : 1;
+            for ( size_t i = n; i-- > 0; ) {
+                if ( a[i] != b[i] ) return a[i] < b[i] ? -1 : 1;
+            }
+            return 0;
+        }
+
+        static std::vector<uint32_t> add( const std::vector<uint32_t>& a, const std::vector<uint32_t>& b )
+        {
+            std::vector<uint32_t> r( std::max( a.size(), b.size() ) + 1 );
+            uint64_t carry = 0;
+            for ( size_t i = 0; i < r.size(); ++i ) {
+                carry += ( i < a.size() ? a[i] : 0ULL ) + ( i < b.size() ? b[i] : 0ULL );
+                r[i] = static_cast<uint32_t>( carry );
+                carry >>= 32;
+            }
+            return r;
+        }
+
+        // |a| >= |b|
+        static std::vector<uint32_t> sub( const std::vector<uint32_t>& a, const std::vector<uint32_t>& b )
+        {
+            std::vector<uint32_t> r( a.size() );
+            int64_t borrow = 0;
+            for ( size_t i = 0; i < a.size(); ++i ) {
+                int64_t d = static_cast<int64_t>( a[i] ) - ( i < b.size() ? b[i] : 0 ) - borrow;
+                borrow = d < 0;
+                r[i] = static_cast<uint32_t>( d + ( borrow << 32 ) );
+            }
+            while ( !r.empty() && r.back() == 0 ) r.pop_back();
+            return r;
+        }
+
+        static std::vector<uint32_t> mul( const std::vector<uint32_t>& a, const std::vector<uint32_t>& b )
+        {
+            std::vector<uint32_t> r( a.size() + b.size() );
+            for ( size_t i = 0; i < a.size(); ++i ) {
+                uint64_t carry = 0;
+                for ( size_t j = 0; j < b.size(); ++j ) {
+                    carry += static_cast<uint64_t>( a[i] ) * b[j] + r[i + j];
+                    r[i + j] = static_cast<uint32_t>( carry );
+                    carry >>= 32;
+                }
+                r[i + b.size()] = static_cast<uint32_t>( carry );
+            }
+            return r;
+        }
+    };
+
+} // namespace fuzz
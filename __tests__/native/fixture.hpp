@@ -0,0 +1,230 @@
+#pragma once
+
+// in-process equivalent of `scripts/deploy.sh` + `cleos`, shared by the native scenario tests
+//
+// `curve.sx` & `eosio.token` are compiled against the `native/include` shim, every transaction
+// runs through `eosio::native::chain` (in-memory tables, inline action queue, revert on failure)
+
+#include "../../curve.sx.cpp"
+#include "../../include/eosio.token/eosio.token.cpp"
+
+#include <eosio/native/chain.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+using eosio::native::chain;
+
+namespace fixture {
+
+    // same values as `__tests__/bats.global.bash`
+    static constexpr int64_t A_LP_TOTAL = 1000000;
+    static constexpr int64_t B_LP_TOTAL = 1000000;
+    static constexpr int64_t C_LP_TOTAL = 1000000;
+    static constexpr int64_t D_LP_TOTAL = 1000000000;
+    static constexpr int64_t E_LP_TOTAL = 1000000000;
+
+    static constexpr int64_t AB_LIQ = 800000;
+    static constexpr int64_t AC_LIQ = 100000;
+    static constexpr int64_t BC_LIQ = 100000;
+    static constexpr int64_t CAB_LIQ = 100000;
+    static constexpr int64_t DE_LIQ = 150000000;
+
+    /**
+     * Failed expectation, reported by `run` as `not ok`
+     */
+    struct failure : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    static int failures = 0;
+    static int tests = 0;
+
+    // TAP output, same test names as the `.bats` files
+    static void run( const string& test, const std::function<void()>& fn )
+    {
+        ++tests;
+        try {
+            fn();
+            printf( "ok %d %s\n", tests, test.c_str() );
+        } catch ( const std::exception& e ) {
+            ++failures;
+            printf( "not ok %d %s\n#   %s\n", tests, test.c_str(), e.what() );
+        }
+    }
+
+    static void expect( const bool condition, const string& message )
+    {
+        if ( !condition ) throw failure( message );
+    }
+
+    static void expect_eq( const string& actual, const string& expected )
+    {
+        expect( actual == expected, "expected \"" + expected + "\", got \"" + actual + "\"" );
+    }
+
+    static void expect_match( const string& output, const string& pattern )
+    {
+        expect( output.find( pattern ) != string::npos, "expected \"" + pattern + "\" in \"" + output + "\"" );
+    }
+
+    /**
+     * ## STRUCT `curve`
+     *
+     * Accounts, contracts & tokens of `scripts/deploy.sh`, driven like `cleos`
+     *
+     * ### example
+     *
+     * ```c++
+     * fixture::curve t;
+     * t.push<sx::curve::init_action>( "curve.sx"_n, "lptoken.sx"_n );
+     * t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AB" );
+     * t.balance( "myaccount"_n, "B" );
+     * // => "1000099.9594 B"
+     * ```
+     */
+    struct curve {
+        chain c;
+
+        curve()
+        {
+            for ( const name account : { "curve.sx"_n, "eosio.token"_n, "fake.token"_n, "myaccount"_n, "myaccount2"_n, "fee.sx"_n, "lptoken.sx"_n, "liquidity.sx"_n } ) {
+                c.create_account( account );
+            }
+            c.set_code<sx::curve>( "curve.sx"_n );
+            c.set_notify<&sx::curve::on_transfer>( "curve.sx"_n, name{}, "transfer"_n );
+            for ( const name token : { "eosio.token"_n, "fake.token"_n, "lptoken.sx"_n } ) {
+                c.set_code<eosio::token>( token );
+            }
+
+            // @eosio.code permission
+            c.add_code_permission( "curve.sx"_n, "curve.sx"_n );
+            c.add_code_permission( "lptoken.sx"_n, "curve.sx"_n );
+
+            // create tokens
+            create( "eosio.token"_n, "100000000.0000 A", "5000000.0000 A" );
+            create( "eosio.token"_n, "100000000.0000 B", "5000000.0000 B" );
+            create( "eosio.token"_n, "100000000.000000000 C", "5000000.000000000 C" );
+            create( "eosio.token"_n, "2000000000.000000 D", "2000000000.000000 D" );
+            create( "eosio.token"_n, "2000000000.000000 E", "2000000000.000000 E" );
+
+            // create fake tokens
+            create( "fake.token"_n, "100000000.0000 A", "5000000.0000 A" );
+            create( "fake.token"_n, "100000000.0000 AB", "5000000.0000 AB" );
+
+            // transfer tokens
+            transfer( "eosio"_n, "myaccount"_n, "1000000.0000 B", "" );
+            transfer( "eosio"_n, "myaccount"_n, "1000000.0000 A", "" );
+            transfer( "eosio"_n, "myaccount"_n, "1000000.0000 A", "", "fake.token"_n );
+            transfer( "eosio"_n, "myaccount"_n, "1000000.000000000 C", "" );
+            transfer( "eosio"_n, "myaccount"_n, "10000000.000000 D", "" );
+            transfer( "eosio"_n, "myaccount"_n, "10000000.000000 E", "" );
+            transfer( "eosio"_n, "liquidity.sx"_n, to_string( A_LP_TOTAL ) + ".0000 B", "" );
+            transfer( "eosio"_n, "liquidity.sx"_n, to_string( B_LP_TOTAL ) + ".0000 A", "" );
+            transfer( "eosio"_n, "liquidity.sx"_n, to_string( C_LP_TOTAL ) + ".000000000 C", "" );
+            transfer( "eosio"_n, "liquidity.sx"_n, to_string( D_LP_TOTAL ) + ".000000 D", "" );
+            transfer( "eosio"_n, "liquidity.sx"_n, to_string( E_LP_TOTAL ) + ".000000 E", "" );
+            transfer( "eosio"_n, "liquidity.sx"_n, "1000000.0000 AB", "", "fake.token"_n );
+        }
+
+        void create( const name contract, const string& maximum_supply, const string& supply )
+        {
+            c.push_action( eosio::token::create_action{ contract, { contract, "active"_n }}.to_action( "eosio"_n, sx::utils::parse_asset( maximum_supply ) ));
+            c.push_action( eosio::token::issue_action{ contract, { "eosio"_n, "active"_n }}.to_action( "eosio"_n, sx::utils::parse_asset( supply ), string{"init"} ));
+        }
+
+        // like `cleos transfer`, `quantity` is rescaled to the precision of the token (ex: "1000 C" => "1000.000000000 C")
+        asset quantity( const name contract, const string& value ) const
+        {
+            const asset parsed = sx::utils::parse_asset( value );
+            check( parsed.symbol.is_valid(), "fixture: invalid asset \"" + value + "\"" );
+            const symbol sym = eosio::token::get_supply( contract, parsed.symbol.code() ).symbol;
+            return asset{ sx::curve::mul_amount( parsed.amount, sym.precision(), parsed.symbol.precision() ), sym };
+        }
+
+        void transfer( const name from, const name to, const string& value, const string& memo, const name contract = "eosio.token"_n )
+        {
+            c.push_action( eosio::token::transfer_action{ contract, { from, "active"_n }}.to_action( from, to, quantity( contract, value ), memo ));
+        }
+
+        // assertion message of a failed transfer, empty if the transfer succeeded
+        string transfer_error( const name from, const name to, const string& value, const string& memo, const name contract = "eosio.token"_n )
+        {
+            return c.push_action_error( eosio::token::transfer_action{ contract, { from, "active"_n }}.to_action( from, to, quantity( contract, value ), memo ));
+        }
+
+        // push `curve.sx` action authorized by `actor`
+        template <typename Action, typename... Args>
+        void push( const name actor, Args&&... args )
+        {
+            c.push_action( Action{ "curve.sx"_n, { actor, "active"_n }}.to_action( std::forward<Args>( args )... ));
+        }
+
+        template <typename Action, typename... Args>
+        string push_error( const name actor, Args&&... args )
+        {
+            return c.push_action_error( Action{ "curve.sx"_n, { actor, "active"_n }}.to_action( std::forward<Args>( args )... ));
+        }
+
+        // like `cleos get currency balance`, empty if no balance row exists
+        string balance( const name owner, const string& symcode, const name contract = "eosio.token"_n ) const
+        {
+            eosio::token::accounts _accounts( contract, owner.value );
+            const auto itr = _accounts.find( symbol_code{ symcode }.raw() );
+            return itr == _accounts.end() ? "" : itr->balance.to_string();
+        }
+
+        asset balance_of( const name owner, const symbol_code symcode, const name contract = "eosio.token"_n ) const
+        {
+            eosio::token::accounts _accounts( contract, owner.value );
+            const auto itr = _accounts.find( symcode.raw() );
+            return itr == _accounts.end() ? asset{ 0, eosio::token::get_supply( contract, symcode ).symbol } : itr->balance;
+        }
+
+        sx::curve::pairs_row pair( const string& pair_id ) const
+        {
+            sx::curve::pairs_table _pairs( "curve.sx"_n, "curve.sx"_n.value );
+            return _pairs.get( symbol_code{ pair_id }.raw(), "fixture: pair does not exist" );
+        }
+
+        sx::curve::pools_row pool( const string& pool_id ) const
+        {
+            sx::curve::pools_table _pools( "curve.sx"_n, "curve.sx"_n.value );
+            return _pools.get( symbol_code{ pool_id }.raw(), "fixture: pool does not exist" );
+        }
+
+        sx::curve::orders_row order( const string& pair_id, const name owner ) const
+        {
+            sx::curve::orders_table _orders( "curve.sx"_n, symbol_code{ pair_id }.raw() );
+            return _orders.get( owner.value, "fixture: order does not exist" );
+        }
+
+        // stored `pairs` row, stands in for a row written by an older contract (ex: `binary_extension` fields reset)
+        sx::curve::pairs_row& legacy_pair( const string& pair_id )
+        {
+            auto& rows = eosio::native::db().get_table<sx::curve::pairs_row>( "curve.sx"_n.value, "curve.sx"_n.value, "pairs"_n.value ).rows;
+            const auto itr = rows.find( symbol_code{ pair_id }.raw() );
+            eosio::check( itr != rows.end(), "fixture: pair does not exist" );
+            return *itr->second;
+        }
+
+        // row of the legacy `ramp` table, as left by an older contract
+        void legacy_ramp( const sx::curve::ramp_row& row )
+        {
+            auto& rows = eosio::native::db().get_table<sx::curve::ramp_row>( "curve.sx"_n.value, "curve.sx"_n.value, "ramp"_n.value ).rows;
+            rows[ row.primary_key() ] = std::make_unique<sx::curve::ramp_row>( row );
+        }
+
+        // nth row of `pairs` in primary key order, like `jq -r '.rows[n]'`
+        sx::curve::pairs_row pair_row( const size_t n ) const
+        {
+            sx::curve::pairs_table _pairs( "curve.sx"_n, "curve.sx"_n.value );
+            auto itr = _pairs.begin();
+            for ( size_t i = 0; i < n; ++i ) ++itr;
+            return *itr;
+        }
+    };
+
+} // namespace fixture
@@ -0,0 +1,46 @@
+// native mirror of `formula.bats`, runs without nodeos (ctest)
+
+#include <eosio/asset.hpp>
+
+using namespace eosio;
+
+#include <sx.safemath/safemath.hpp>
+#include <curve.hpp>
+
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+
+static void expect( const char* test, const uint64_t amount, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const std::string& expected )
+{
+    std::string output;
+    try {
+        output = std::to_string( Curve::get_amount_out( amount, reserve_in, reserve_out, amplifier, 4 ) );
+    } catch ( const eosio_assert_message_exception& e ) {
+        output = e.what();
+    }
+    const bool ok = output.find( expected ) != std::string::npos;
+    if ( !ok ) ++failures;
+    printf( "%s %s: %s\n", ok ? "ok" : "not ok", test, output.c_str() );
+}
+
+int main()
+{
+    const uint64_t amplifier = 450;
+    const uint64_t reserve1 = 5862496056;
+    const uint64_t reserve2 = 6260058778;
+
+    expect( "curve formula #1", 10000000, reserve1, reserve2, amplifier, "9997422" );
+    expect( "curve formula #2", 10000000, reserve2, reserve1, amplifier, "9994508" );
+    expect( "curve formula #3", 10000000000, reserve1, reserve2, amplifier, "6249264902" );
+    expect( "curve formula #4", 10000000000, reserve2, reserve1, amplifier, "5852835188" );
+    expect( "curve formula #5", 10000000, 1000000000000000000, 1000000000000000000, 5, "9996000" );
+    expect( "curve formula #6", 10000000, 4000000000000000000, 4000000000000000000, 2, "9996000" );
+    expect( "curve formula #7", 10000000, 9500000000000000000ULL, 9500000000000000000ULL, amplifier, "invalid reserves" );
+    expect( "curve formula #8", 5564108240870, 2857376198546, 5603821613576, 884, "5482150499488" );
+    expect( "curve formula #9", 1000000000000000000, 1000000000000000000, 4611686018427387000, amplifier, "1003430807411377620" );
+    expect( "curve formula #10", 5889684945, 85692935855, 10607069950, 22, "3683332307" );
+
+    return failures ? 1 : 0;
+}
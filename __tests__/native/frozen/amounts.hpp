@@ -0,0 +1,70 @@
+#pragma once
+
+// frozen snapshot of `sx.rex`, `curve::mul_amount` / `div_amount` and the `curve::deposit` / `withdraw_liquidity` ratio math,
+// reference for `__tests__/native/fuzz.cpp`
+// do not edit: optimized versions are diffed against this copy
+
+#include <sx.safemath/safemath.hpp>
+
+#include <utility>
+
+namespace frozen {
+
+    static uint64_t issue( const uint64_t payment, const uint64_t deposit, const uint64_t supply, const uint16_t ratio = 10000 )
+    {
+        eosio::check(payment > 0, "SX.REX: INSUFFICIENT_PAYMENT_AMOUNT");
+        if ( supply == 0 ) return payment * ratio;
+        return ((uint128_t(deposit + payment) * supply) / deposit) - supply;
+    }
+
+    static uint64_t retire( const uint64_t payment, const uint64_t deposit, const uint64_t supply )
+    {
+        eosio::check(payment > 0, "SX.REX: INSUFFICIENT_PAYMENT_AMOUNT");
+        eosio::check(deposit > 0, "SX.REX: INSUFFICIENT_DEPOSIT_AMOUNT");
+        eosio::check(supply > 0, "SX.REX: INSUFFICIENT_SUPPLY_AMOUNT");
+        return (uint128_t(payment) * deposit) / supply;
+    }
+
+    static int64_t mul_amount( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+    {
+        eosio::check(amount >= 0, "curve::mul_amount: mul/div overflow");
+        if ( precision0 == precision1 ) return amount;
+        if ( precision0 < precision1 ) return amount / safemath::pow10( precision1 - precision0 );
+
+        const int64_t factor = safemath::pow10( precision0 - precision1 );
+        eosio::check(amount <= INT64_MAX / factor, "curve::mul_amount: mul/div overflow");
+        return amount * factor;
+    }
+
+    static int64_t div_amount( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+    {
+        if ( precision0 == precision1 ) return amount;
+        if ( precision0 > precision1 ) return amount / safemath::pow10( precision0 - precision1 );
+
+        const int64_t factor = safemath::pow10( precision1 - precision0 );
+        eosio::check(amount <= INT64_MAX / factor && amount >= INT64_MIN / factor, "curve::div_amount: mul overflow");
+        return amount * factor;
+    }
+
+    static std::pair<int128_t, int128_t> get_deposit_amounts( const int128_t amount0, const int128_t amount1, const int128_t reserve0, const int128_t reserve1 )
+    {
+        const int128_t reserves = reserve0 + reserve1;
+        const int128_t payment = amount0 + amount1;
+        const int128_t deposit0 = (amount0 * reserves <= reserve0 * payment) ? amount0 : (amount1 * reserve0 / reserve1);
+        const int128_t deposit1 = (amount0 * reserves <= reserve0 * payment) ? (amount0 * reserve1 / reserve0) : amount1;
+        return { deposit0, deposit1 };
+    }
+
+    static std::pair<int64_t, int64_t> get_withdraw_amounts( const int64_t retire_amount, const int128_t reserve0, const int128_t reserve1 )
+    {
+        const int128_t reserves = reserve0 + reserve1;
+        int64_t amount0 = static_cast<int64_t>( retire_amount * reserve0 / reserves );
+        int64_t amount1 = static_cast<int64_t>( retire_amount * reserve1 / reserves );
+        if (amount0 == reserve0 || amount1 == reserve1) {
+            amount0 = static_cast<int64_t>( reserve0 );
+            amount1 = static_cast<int64_t>( reserve1 );
+        }
+        return { amount0, amount1 };
+    }
+
+} // namespace frozen
@@ -0,0 +1,84 @@
+#pragma once
+
+// frozen snapshot of the baseline `curve.hpp` Newton loops (f1b5fa0, doc comments stripped), reference for `__tests__/native/fuzz.cpp`
+// do not edit: the solver fast paths (seeded D, closed form y, wide intermediates) are diffed against this copy
+//
+// `get_amount_out` is split into its D & x loops, the only additions are guards returning no result where the baseline
+// would trap (division by zero, ex: get_amount_out(10, 10, 10, 362, 24)), wrap 128-bit intermediates or stop before converging
+
+#include <optional>
+#include <sx.safemath/safemath.hpp>
+
+using namespace eosio;
+
+namespace frozen::Curve {
+    const int MAX_ITERATIONS = 10;
+
+    static bool mul_overflows( const uint128_t a, const uint128_t b, uint128_t& result )
+    {
+        return __builtin_mul_overflow( a, b, &result );
+    }
+
+    // D loop of the baseline `get_amount_out`
+    static std::optional<uint64_t> get_invariant( const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier )
+    {
+        eosio::check(amplifier > 0, "curve.sx::get_amount_out: invalid amplifier");
+        eosio::check(reserve_in > 0 && reserve_out > 0, "curve.sx::get_amount_out: insufficient liquidity");
+        eosio::check(reserve_in < (1LL << 62) - 1 && reserve_out < (1LL << 62) - 1, "curve.sx::get_amount_out: invalid reserves");
+
+        // calculate invariant D by solving quadratic equation:
+        // A * sum * n^n + D = A * D * n^n + D^(n+1) / (n^n * prod), where n==2
+        const uint64_t sum = reserve_in + reserve_out;
+        uint128_t D = sum, D_prev = 0;
+        int i = MAX_ITERATIONS;
+        while ( D != D_prev && i--) {
+            uint128_t prod1, numerator, denominator;
+            if ( mul_overflows( D, D, prod1 ) ) return {};
+            if ( mul_overflows( prod1 / (reserve_in * 2), D, prod1 ) ) return {};
+            prod1 /= reserve_out * 2;
+            D_prev = D;
+            check((uint64_t)(safemath::mul( amplifier, sum ) + prod1) == safemath::mul( amplifier, sum ) + prod1, "curve.sx::get_amount_out: d1 overflow");
+            if ( mul_overflows( 2 * D, safemath::mul(amplifier, sum) + prod1, numerator ) ) return {};
+            if ( mul_overflows( 2 * amplifier - 1, D, denominator ) || denominator + 3 * prod1 < denominator ) return {};
+            denominator += 3 * prod1;
+            if ( denominator == 0 ) return {};
+            D = numerator / denominator;
+        }
+        if ( D != D_prev ) return {};
+
+        check((uint64_t)D == D, "curve.sx::get_amount_out: d2 overflow");
+        return static_cast<uint64_t>( D );
+    }
+
+    // x loop of the baseline `get_amount_out` for a known invariant D
+    static std::optional<uint64_t> get_amount_out( const uint64_t amount_in, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee, const uint64_t invariant )
+    {
+        // calculate x - new value for reserve_out by solving quadratic equation iteratively:
+        // x^2 + x * (sum' - (An^n - 1) * D / (An^n)) = D ^ (n + 1) / (n^(2n) * prod' * A), where n==2
+        // x^2 + b*x = c
+        const uint128_t D = invariant;
+        const uint64_t reserve_in_next = reserve_in + amount_in;
+        if ( reserve_in_next < reserve_in || reserve_in_next * 2 < reserve_in_next ) return {};
+        const int128_t b = (int128_t) ((reserve_in + amount_in) + (D / (amplifier * 2))) - (int128_t) D;
+        uint128_t c;
+        if ( mul_overflows( D * D / ((reserve_in + amount_in) * 2), D, c ) ) return {};
+        c /= amplifier * 4;
+        uint128_t x = D, x_prev = 0;
+        int i = MAX_ITERATIONS;
+        while ( x != x_prev && i--) {
+            x_prev = x;
+            uint128_t numerator;
+            if ( mul_overflows( x, x, numerator ) || numerator + c < numerator ) return {};
+            const uint128_t denominator = 2 * x + b;
+            if ( denominator == 0 ) return {};
+            x = (numerator + c) / denominator;
+        }
+        if ( x != x_prev ) return {};
+        check(reserve_out > x, "curve.sx::get_amount_out: insufficient reserve out");
+        const uint64_t amount_out = reserve_out - (uint64_t)x;
+
+        uint64_t fee_amount;
+        if ( __builtin_mul_overflow( static_cast<uint64_t>( fee ), amount_out, &fee_amount ) ) return {};
+        return amount_out - fee_amount / 10000;
+    }
+}
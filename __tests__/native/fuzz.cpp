@@ -0,0 +1,531 @@
+// differential fuzzing of the contract math
+//
+// every target runs the current implementation, the frozen copy (`frozen/`) and a slow big integer reference (`bigint.hpp`):
+// the current implementation must match the frozen copy exactly (values & error messages) and the reference
+// wherever the reference is in domain (intermediates within the documented 128/256-bit bounds)
+// 2-reserve solver results are compared to the frozen baseline Newton loops wherever the baseline returns a result
+//
+// targets: get_invariant<2,3,4>, get_amount_out<2,3,4>, get_amount_in, rex::issue / rex::retire,
+//          curve::mul_amount / div_amount, curve::get_deposit_amounts / get_withdraw_amounts
+//
+// ./curve.fuzz [iterations=100000 | <seconds>s] [seed=1] [target]
+// libFuzzer: cmake -DCURVE_LIBFUZZER=ON (clang), ./curve.libfuzzer corpus/
+
+#include "fixture.hpp"
+#include "bigint.hpp"
+#include "frozen/curve.hpp"
+#include "frozen/amounts.hpp"
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <sstream>
+
+using namespace fixture;
+using fuzz::bigint;
+
+namespace fuzz {
+
+    /**
+     * Input stream, `mt19937_64` in property mode or the libFuzzer bytes (zeros once exhausted)
+     */
+    struct source {
+        virtual ~source() = default;
+        virtual uint64_t next() = 0;
+    };
+
+    struct random_source : source {
+        std::mt19937_64 rng;
+        explicit random_source( const uint64_t seed ) : rng( seed ) {}
+        uint64_t next() override { return rng(); }
+    };
+
+    struct bytes_source : source {
+        const uint8_t* data;
+        size_t size;
+        bytes_source( const uint8_t* data, const size_t size ) : data( data ), size( size ) {}
+        uint64_t next() override
+        {
+            uint64_t value = 0;
+            for ( int i = 0; i < 8 && size; ++i, ++data, --size ) value |= uint64_t( *data ) << ( 8 * i );
+            return value;
+        }
+    };
+
+    // value in [min, max] biased toward edges: small values, values near max, powers of ten +-1, log-uniform
+    static uint64_t value( source& s, const uint64_t min, const uint64_t max )
+    {
+        const uint64_t pick = s.next() % 8, x = s.next();
+        const uint64_t range = max - min;
+        uint64_t v;
+        switch ( pick ) {
+            case 0: v = min + ( range ? x % std::min<uint64_t>( range + 1, 16 ) : 0 ); break;
+            case 1: v = max - ( range ? x % std::min<uint64_t>( range + 1, 16 ) : 0 ); break;
+            case 2: {
+                const uint64_t p = safemath::pow10( x % 19 );
+                v = p + ( x >> 8 ) % 3 - 1;
+                break;
+            }
+            default: {
+                const int bits = 1 + x % 64;
+                const uint64_t r = s.next();
+                v = bits == 64 ? r : r & ( ( uint64_t(1) << bits ) - 1 );
+            }
+        }
+        if ( v < min || v > max ) v = range == UINT64_MAX ? v : min + v % ( range + 1 );
+        return v;
+    }
+
+    // `fraction` of `base` with up to 1% jitter (balanced reserves exercise the seeded fast path)
+    static uint64_t near( source& s, const uint64_t base, const uint64_t max )
+    {
+        const uint64_t jitter = base / 100 ? s.next() % ( base / 100 ) : 0;
+        const uint64_t v = s.next() % 2 ? base + jitter : base - jitter;
+        return std::clamp<uint64_t>( v, 1, max );
+    }
+
+    static std::map<string, uint64_t> out_of_domain;
+    static std::map<string, uint64_t> out_of_baseline;
+
+    // runs `fn`, "error: <message>" when an `eosio::check` fails
+    template <typename F>
+    static string outcome( F&& fn )
+    {
+        try {
+            return fn();
+        } catch ( const eosio::eosio_assert_message_exception& e ) {
+            return string( "error: " ) + e.what();
+        }
+    }
+
+    static string str( const uint128_t value )
+    {
+        return bigint::from_unsigned( value ).to_string();
+    }
+
+    static string str( const int128_t value )
+    {
+        return bigint( value ).to_string();
+    }
+
+    template <typename T, size_t N>
+    static string str( const std::array<T, N>& values )
+    {
+        string result = "[";
+        for ( size_t i = 0; i < N; ++i ) result += ( i ? "," : "" ) + str( static_cast<uint128_t>( values[i] ) );
+        return result + "]";
+    }
+
+    static bool is_error( const string& result )
+    {
+        return result.rfind( "error: ", 0 ) == 0;
+    }
+
+    static void expect_same( const string& target, const string& inputs, const string& current, const string& expected, const char* against )
+    {
+        if ( current != expected ) throw failure( target + "(" + inputs + "): " + current + " != " + expected + " (" + against + ")" );
+    }
+
+    // reference result: no value when the implementation must fail, `in_domain` false when intermediates exceed the documented bounds
+    struct reference_result {
+        bool in_domain = true;
+        std::optional<bigint> value;
+    };
+
+    static void expect_reference( const string& target, const string& inputs, const string& current, const reference_result& reference )
+    {
+        if ( !reference.in_domain ) {
+            out_of_domain[ target ]++;
+            return;
+        }
+        if ( !reference.value ) {
+            if ( !is_error( current ) ) throw failure( target + "(" + inputs + "): " + current + " != error (reference)" );
+            return;
+        }
+        expect_same( target, inputs, current, reference.value->to_string(), "reference" );
+    }
+
+    // frozen baseline result, inputs where the baseline fails or returns no result are skipped
+    template <typename F>
+    static void expect_baseline( const string& target, const string& inputs, const string& current, F&& fn )
+    {
+        std::optional<uint64_t> expected;
+        try {
+            expected = fn();
+        } catch ( const eosio::eosio_assert_message_exception& ) {}
+
+        if ( !expected ) {
+            out_of_baseline[ target ]++;
+            return;
+        }
+        expect_same( target, inputs, current, std::to_string( *expected ), "frozen" );
+    }
+
+} // namespace fuzz
+
+namespace reference {
+
+    static const bigint TWO_128 = bigint::from_unsigned( ~uint128_t(0) ) + 1;
+    static const bigint TWO_64 = bigint::from_unsigned( uint128_t(1) << 64 );
+
+    // Newton iteration of `get_invariant<N>` in exact arithmetic (same flooring order, no overflow)
+    template <uint8_t N>
+    static fuzz::reference_result get_invariant( const std::array<uint64_t, N>& reserves, const uint64_t amplifier )
+    {
+        bigint sum = 0;
+        for ( const uint64_t reserve : reserves ) sum = sum + reserve;
+
+        bigint D = sum, D_prev = 0;
+        for ( int iterations = 0; D != D_prev && iterations < Curve::MAX_ITERATIONS; ++iterations ) {
+            bigint prod1 = D;
+            for ( const uint64_t reserve : reserves ) prod1 = prod1 * D / ( bigint( reserve ) * N );
+            const bigint d1 = bigint( amplifier ) * sum + prod1;
+            const bigint denominator = ( bigint( amplifier ) * N - 1 ) * D + bigint( N + 1 ) * prod1;
+
+            // the wide solver keeps prod1, d1 & the denominator within 128 bits
+            if ( prod1 >= TWO_128 || d1 >= TWO_128 || denominator >= TWO_128 ) return { false, {} };
+            D_prev = D;
+            D = bigint( N ) * D * d1 / denominator;
+        }
+        if ( D >= TWO_64 ) return {}; // d2 overflow
+        return { true, D };
+    }
+
+    // largest x such that x * (x + b) <= c
+    static bigint get_y( const bigint& b, const bigint& c )
+    {
+        bigint lo = b.is_negative() ? -b : bigint( 0 ), hi = lo + 1;
+        auto fits = [&]( const bigint& x ) { return x * ( x + b ) <= c; };
+        while ( fits( hi ) ) hi = hi * 2;
+        while ( hi - lo > 1 ) {
+            const bigint mid = ( lo + hi ) / 2;
+            if ( fits( mid ) ) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    template <uint8_t N>
+    static fuzz::reference_result get_amount_out( const uint64_t amount_in, const std::array<uint64_t, N>& reserves, const uint8_t index_in, const uint8_t index_out, const uint64_t amplifier, const uint8_t fee, const uint64_t invariant )
+    {
+        const bigint D = invariant;
+        bigint sum = 0, c = D;
+        for ( uint8_t k = 0; k < N; k++ ) {
+            if ( k == index_out ) continue;
+            const bigint reserve = k == index_in ? bigint( reserves[k] ) + amount_in : bigint( reserves[k] );
+            sum = sum + reserve;
+            c = c * D / ( reserve * N );
+            if ( c >= TWO_128 ) return { false, {} };
+        }
+        c = c * D / ( bigint( amplifier ) * N * N );
+        const bigint b = sum + D / ( bigint( amplifier ) * N ) - D;
+        const bigint x = get_y( b, c );
+        if ( bigint( reserves[index_out] ) <= x ) return {}; // insufficient reserve out
+
+        const bigint amount_out = bigint( reserves[index_out] ) - x;
+        return { true, amount_out - bigint( fee ) * amount_out / 10000 };
+    }
+
+    static fuzz::reference_result issue( const uint64_t payment, const uint64_t deposit, const uint64_t supply, const uint16_t ratio )
+    {
+        if ( payment == 0 ) return {};
+        const bigint issued = supply == 0 ? bigint( payment ) * ratio : ( bigint( deposit ) + payment ) * supply / deposit - supply;
+        if ( !issued.fits_uint64() ) return { false, {} };
+        return { true, issued };
+    }
+
+    static fuzz::reference_result retire( const uint64_t payment, const uint64_t deposit, const uint64_t supply )
+    {
+        if ( payment == 0 || deposit == 0 || supply == 0 ) return {};
+        const bigint retired = bigint( payment ) * deposit / supply;
+        if ( !retired.fits_uint64() ) return { false, {} };
+        return { true, retired };
+    }
+
+    static fuzz::reference_result mul_amount( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+    {
+        if ( amount < 0 ) return {};
+        if ( precision0 < precision1 ) return { true, bigint( amount ) / safemath::pow10( precision1 - precision0 ) };
+        const bigint value = bigint( amount ) * safemath::pow10( precision0 - precision1 );
+        if ( value > bigint( INT64_MAX ) ) return {};
+        return { true, value };
+    }
+
+    // integer division truncates toward zero
+    static fuzz::reference_result div_amount( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+    {
+        if ( precision0 > precision1 ) {
+            const bigint magnitude = bigint( amount ).abs() / safemath::pow10( precision0 - precision1 );
+            return { true, amount < 0 ? -magnitude : magnitude };
+        }
+        const bigint value = bigint( amount ) * safemath::pow10( precision1 - precision0 );
+        if ( value > bigint( INT64_MAX ) || value < bigint( INT64_MIN ) ) return {};
+        return { true, value };
+    }
+
+    // same ratio test as `curve::deposit`, simplified: amount0 * reserves <= reserve0 * payment <=> amount0 * reserve1 <= amount1 * reserve0
+    static std::pair<bigint, bigint> get_deposit_amounts( const bigint& amount0, const bigint& amount1, const bigint& reserve0, const bigint& reserve1 )
+    {
+        if ( amount0 * reserve1 <= amount1 * reserve0 ) return { amount0, amount0 * reserve1 / reserve0 };
+        return { amount1 * reserve0 / reserve1, amount1 };
+    }
+
+    static std::pair<bigint, bigint> get_withdraw_amounts( const bigint& retire_amount, const bigint& reserve0, const bigint& reserve1 )
+    {
+        const bigint amount0 = retire_amount * reserve0 / ( reserve0 + reserve1 );
+        const bigint amount1 = retire_amount * reserve1 / ( reserve0 + reserve1 );
+        if ( amount0 == reserve0 || amount1 == reserve1 ) return { reserve0, reserve1 };
+        return { amount0, amount1 };
+    }
+
+} // namespace reference
+
+namespace targets {
+
+    using fuzz::source;
+    using fuzz::value;
+    using fuzz::str;
+
+    static constexpr uint64_t MAX_RESERVE = (1ULL << 62) - 2;
+
+    template <uint8_t N>
+    static std::array<uint64_t, N> reserves( source& s )
+    {
+        std::array<uint64_t, N> result;
+        const bool balanced = s.next() % 2;
+        const uint64_t base = value( s, 1, MAX_RESERVE );
+        for ( auto& reserve : result ) reserve = balanced ? fuzz::near( s, base, MAX_RESERVE ) : value( s, 1, MAX_RESERVE );
+        return result;
+    }
+
+    template <uint8_t N>
+    static void get_invariant( source& s )
+    {
+        const auto R = reserves<N>( s );
+        const uint64_t amplifier = value( s, 1, MAX_AMPLIFIER );
+        const string inputs = str( R ) + ", " + std::to_string( amplifier );
+        const string target = "get_invariant<" + std::to_string( N ) + ">";
+
+        const string current = fuzz::outcome( [&]() { return std::to_string( Curve::get_invariant<N>( R, amplifier ) ); });
+        if constexpr ( N == 2 ) fuzz::expect_baseline( target, inputs, current, [&]() { return frozen::Curve::get_invariant( R[0], R[1], amplifier ); });
+        fuzz::expect_reference( target, inputs, current, reference::get_invariant<N>( R, amplifier ) );
+    }
+
+    template <uint8_t N>
+    static void get_amount_out( source& s )
+    {
+        const auto R = reserves<N>( s );
+        const uint64_t amplifier = value( s, 1, MAX_AMPLIFIER );
+        const uint8_t fee = s.next() % 256;
+        const uint8_t index_in = s.next() % N;
+        const uint8_t index_out = ( index_in + 1 + s.next() % ( N - 1 )) % N;
+        const uint64_t amount_in = value( s, 1, s.next() % 4 ? R[index_in] : MAX_RESERVE );
+        const string inputs = std::to_string( amount_in ) + ", " + str( R ) + ", " + std::to_string( index_in ) + ", " + std::to_string( index_out ) + ", " + std::to_string( amplifier ) + ", " + std::to_string( fee );
+        const string target = "get_amount_out<" + std::to_string( N ) + ">";
+
+        uint64_t invariant;
+        try {
+            invariant = Curve::get_invariant<N>( R, amplifier );
+        } catch ( const eosio::eosio_assert_message_exception& ) {
+            return; // covered by `get_invariant`
+        }
+        const string current = fuzz::outcome( [&]() { return std::to_string( Curve::get_amount_out<N>( amount_in, R, index_in, index_out, amplifier, fee, invariant )); });
+        if constexpr ( N == 2 ) fuzz::expect_baseline( target, inputs, current, [&]() { return frozen::Curve::get_amount_out( amount_in, R[index_in], R[index_out], amplifier, fee, invariant ); });
+        fuzz::expect_reference( target, inputs, current, reference::get_amount_out<N>( amount_in, R, index_in, index_out, amplifier, fee, invariant ));
+    }
+
+    // smallest input returning at least `amount_out`
+    static void get_amount_in( source& s )
+    {
+        const auto R = reserves<2>( s );
+        const uint64_t amplifier = value( s, 1, MAX_AMPLIFIER );
+        const uint8_t fee = s.next() % ( MAX_TRADE_FEE + 1 );
+        const uint64_t amount_out = value( s, 1, R[1] );
+        const string inputs = std::to_string( amount_out ) + ", " + str( R ) + ", " + std::to_string( amplifier ) + ", " + std::to_string( fee );
+
+        uint64_t invariant;
+        try {
+            invariant = Curve::get_invariant<2>( R, amplifier );
+        } catch ( const eosio::eosio_assert_message_exception& ) {
+            return;
+        }
+        uint64_t amount_in = 0;
+        const string current = fuzz::outcome( [&]() { amount_in = Curve::get_amount_in( amount_out, R[0], R[1], amplifier, fee, invariant ); return std::to_string( amount_in ); });
+        if ( fuzz::is_error( current ) ) return;
+
+        auto out = [&]( const uint64_t in ) -> uint64_t {
+            try {
+                return Curve::get_amount_out( in, R[0], R[1], amplifier, fee, invariant );
+            } catch ( const eosio::eosio_assert_message_exception& ) {
+                return 0;
+            }
+        };
+        if ( out( amount_in ) < amount_out || out( amount_in - 1 ) >= amount_out ) {
+            throw failure( "get_amount_in(" + inputs + "): " + current + " is not the smallest input for " + std::to_string( amount_out ));
+        }
+    }
+
+    static void rex( source& s )
+    {
+        const uint64_t payment = s.next() % 16 ? value( s, 1, MAX_RESERVE ) : 0;
+        const uint64_t deposit = value( s, 1, MAX_RESERVE );
+        const uint64_t supply = s.next() % 16 ? value( s, 1, MAX_RESERVE ) : 0;
+        const uint16_t ratio = s.next() % 2 ? 1 : value( s, 1, 10000 );
+        const string inputs = std::to_string( payment ) + ", " + std::to_string( deposit ) + ", " + std::to_string( supply );
+
+        const string issued = fuzz::outcome( [&]() { return std::to_string( rex::issue( payment, deposit, supply, ratio )); });
+        fuzz::expect_same( "rex::issue", inputs, issued, fuzz::outcome( [&]() { return std::to_string( frozen::issue( payment, deposit, supply, ratio )); }), "frozen" );
+        fuzz::expect_reference( "rex::issue", inputs, issued, reference::issue( payment, deposit, supply, ratio ));
+
+        const string retired = fuzz::outcome( [&]() { return std::to_string( rex::retire( payment, deposit, supply )); });
+        fuzz::expect_same( "rex::retire", inputs, retired, fuzz::outcome( [&]() { return std::to_string( frozen::retire( payment, deposit, supply )); }), "frozen" );
+        fuzz::expect_reference( "rex::retire", inputs, retired, reference::retire( payment, deposit, supply ));
+    }
+
+    static void amounts( source& s )
+    {
+        const bool is_mul = s.next() % 2;
+        // trades always rescale between `MAX_PRECISION` and token precisions
+        const uint8_t precision0 = s.next() % 2 ? MAX_PRECISION : s.next() % 19;
+        const uint8_t precision1 = s.next() % 19;
+        const uint64_t magnitude = value( s, 0, INT64_MAX );
+        const int64_t amount = s.next() % ( is_mul ? 32 : 4 ) ? static_cast<int64_t>( magnitude ) : -static_cast<int64_t>( magnitude );
+        const string target = is_mul ? "mul_amount" : "div_amount";
+        const string inputs = std::to_string( amount ) + ", " + std::to_string( precision0 ) + ", " + std::to_string( precision1 );
+
+        const string current = fuzz::outcome( [&]() { return std::to_string( is_mul ? sx::curve::mul_amount( amount, precision0, precision1 ) : sx::curve::div_amount( amount, precision0, precision1 )); });
+        fuzz::expect_same( target, inputs, current, fuzz::outcome( [&]() { return std::to_string( is_mul ? frozen::mul_amount( amount, precision0, precision1 ) : frozen::div_amount( amount, precision0, precision1 )); }), "frozen" );
+        fuzz::expect_reference( target, inputs, current, is_mul ? reference::mul_amount( amount, precision0, precision1 ) : reference::div_amount( amount, precision0, precision1 ));
+    }
+
+    static void deposit( source& s )
+    {
+        const int64_t amount0 = value( s, 1, INT64_MAX ), amount1 = value( s, 1, INT64_MAX );
+        const int64_t reserve0 = value( s, 1, INT64_MAX );
+        const int64_t reserve1 = s.next() % 2 ? fuzz::near( s, reserve0, INT64_MAX ) : value( s, 1, INT64_MAX );
+        const string inputs = std::to_string( amount0 ) + ", " + std::to_string( amount1 ) + ", " + std::to_string( reserve0 ) + ", " + std::to_string( reserve1 );
+
+        const auto [ deposit0, deposit1 ] = sx::curve::get_deposit_amounts( amount0, amount1, reserve0, reserve1 );
+        const auto [ frozen0, frozen1 ] = frozen::get_deposit_amounts( amount0, amount1, reserve0, reserve1 );
+        const auto [ reference0, reference1 ] = reference::get_deposit_amounts( amount0, amount1, reserve0, reserve1 );
+        const string current = str( deposit0 ) + "," + str( deposit1 );
+
+        fuzz::expect_same( "get_deposit_amounts", inputs, current, str( frozen0 ) + "," + str( frozen1 ), "frozen" );
+        fuzz::expect_same( "get_deposit_amounts", inputs, current, reference0.to_string() + "," + reference1.to_string(), "reference" );
+        if ( deposit0 > amount0 || deposit1 > amount1 ) throw failure( "get_deposit_amounts(" + inputs + "): " + current + " exceeds the order" );
+    }
+
+    static void withdraw( source& s )
+    {
+        const int64_t reserve0 = value( s, 1, INT64_MAX );
+        const int64_t reserve1 = s.next() % 2 ? fuzz::near( s, reserve0, INT64_MAX ) : value( s, 1, INT64_MAX );
+        const int64_t retire_amount = value( s, 1, std::min<uint64_t>( uint64_t( reserve0 ) + reserve1, INT64_MAX ));
+        const string inputs = std::to_string( retire_amount ) + ", " + std::to_string( reserve0 ) + ", " + std::to_string( reserve1 );
+
+        const auto [ amount0, amount1 ] = sx::curve::get_withdraw_amounts( retire_amount, reserve0, reserve1 );
+        const auto [ frozen0, frozen1 ] = frozen::get_withdraw_amounts( retire_amount, reserve0, reserve1 );
+        const auto [ reference0, reference1 ] = reference::get_withdraw_amounts( retire_amount, reserve0, reserve1 );
+        const string current = std::to_string( amount0 ) + "," + std::to_string( amount1 );
+
+        fuzz::expect_same( "get_withdraw_amounts", inputs, current, std::to_string( frozen0 ) + "," + std::to_string( frozen1 ), "frozen" );
+        fuzz::expect_same( "get_withdraw_amounts", inputs, current, reference0.to_string() + "," + reference1.to_string(), "reference" );
+        if ( amount0 > reserve0 || amount1 > reserve1 || int128_t( amount0 ) + amount1 > retire_amount ) throw failure( "get_withdraw_amounts(" + inputs + "): " + current + " exceeds the reserves" );
+    }
+
+    static const std::vector<std::pair<string, void (*)( source& )>> all = {
+        { "get_invariant<2>", get_invariant<2> },
+        { "get_invariant<3>", get_invariant<3> },
+        { "get_invariant<4>", get_invariant<4> },
+        { "get_amount_out<2>", get_amount_out<2> },
+        { "get_amount_out<3>", get_amount_out<3> },
+        { "get_amount_out<4>", get_amount_out<4> },
+        { "get_amount_in", get_amount_in },
+        { "rex", rex },
+        { "amounts", amounts },
+        { "deposit", deposit },
+        { "withdraw", withdraw },
+    };
+
+} // namespace targets
+
+#ifdef CURVE_LIBFUZZER
+
+// first byte selects the target, the rest feeds its inputs
+extern "C" int LLVMFuzzerTestOneInput( const uint8_t* data, size_t size )
+{
+    if ( size == 0 ) return 0;
+    fuzz::bytes_source s( data + 1, size - 1 );
+    try {
+        targets::all[ data[0] % targets::all.size() ].second( s );
+    } catch ( const failure& e ) {
+        fprintf( stderr, "%s\n", e.what() );
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+int main( int argc, char** argv )
+{
+    const string limit = argc > 1 ? argv[1] : "100000";
+    const uint64_t seed = argc > 2 ? std::stoull( argv[2] ) : 1;
+    const string filter = argc > 3 ? argv[3] : "";
+
+    // "<n>s" runs the targets round-robin for n seconds (long campaigns), otherwise n iterations per target
+    const bool timed = !limit.empty() && limit.back() == 's';
+    const uint64_t iterations = timed ? 0 : std::stoull( limit );
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( timed ? std::stoull( limit ) : 0 );
+
+    struct campaign {
+        string name;
+        void (*target)( fuzz::source& );
+        std::unique_ptr<fuzz::random_source> source;
+        uint64_t execs = 0;
+        double seconds = 0;
+    };
+    std::vector<campaign> campaigns;
+    for ( const auto& [ name, target ] : targets::all ) {
+        if ( filter.empty() || name.find( filter ) != string::npos ) campaigns.push_back({ name, target, std::make_unique<fuzz::random_source>( seed ^ std::hash<string>{}( name )) });
+    }
+
+    // batch of `count` execs, failures carry the seed & exec index to reproduce
+    auto batch = [&]( campaign& c, const uint64_t count ) {
+        const auto start = std::chrono::steady_clock::now();
+        for ( uint64_t i = 0; i < count; ++i, ++c.execs ) {
+            try {
+                c.target( *c.source );
+            } catch ( const failure& e ) {
+                throw failure( string( e.what() ) + " [exec " + std::to_string( c.execs ) + "]" );
+            }
+        }
+        c.seconds += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    };
+
+    if ( timed ) {
+        run( "campaign " + limit + " (seed " + std::to_string( seed ) + ")", [&]() {
+            while ( std::chrono::steady_clock::now() < deadline ) {
+                for ( auto& c : campaigns ) batch( c, 100 );
+            }
+        });
+    } else {
+        for ( auto& c : campaigns ) {
+            run( c.name + " (seed " + std::to_string( seed ) + ")", [&]() { batch( c, iterations ); });
+        }
+    }
+
+    for ( const auto& c : campaigns ) {
+        printf( "# %-18s %10llu execs %10.0f execs/s\n", c.name.c_str(), (unsigned long long) c.execs, c.seconds > 0 ? c.execs / c.seconds : 0 );
+    }
+    for ( const auto& [ target, count ] : fuzz::out_of_domain ) {
+        printf( "# %s: %llu inputs beyond the reference domain (frozen copy only)\n", target.c_str(), (unsigned long long) count );
+    }
+    for ( const auto& [ target, count ] : fuzz::out_of_baseline ) {
+        printf( "# %s: %llu inputs without a frozen baseline result\n", target.c_str(), (unsigned long long) count );
+    }
+
+    printf( "1..%d\n", tests );
+    return failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,139 @@
+// `CURVE_PROFILE` build: per action counters of table operations, inline actions & solver iterations
+//
+// prints the `profile:` console line of every `curve.sx` action for 1-3 hop swaps, pool swap, deposit & withdraw
+//
+// ./curve.profile
+
+#include "fixture.hpp"
+
+#include <map>
+
+using namespace fixture;
+
+static fixture::curve t;
+
+// `profile:<action> key=value ...` console lines of `curve.sx` in the last transaction
+static std::vector<std::map<string, uint64_t>> profiles()
+{
+    std::vector<std::map<string, uint64_t>> result;
+    for ( const auto& trace : t.c.traces() ) {
+        if ( trace.receiver != "curve.sx"_n || trace.console.rfind( "profile:", 0 ) != 0 ) continue;
+        printf( "#   %s", trace.console.c_str() );
+
+        std::map<string, uint64_t> counters;
+        std::istringstream line( trace.console );
+        string field;
+        while ( line >> field ) {
+            const auto pos = field.find( '=' );
+            if ( pos != string::npos ) counters[ field.substr( 0, pos ) ] = std::stoull( field.substr( pos + 1 ) );
+        }
+        result.push_back( counters );
+    }
+    return result;
+}
+
+// counters of the `on_transfer` notification of the last transaction
+static std::map<string, uint64_t> on_transfer( const string& quantity, const string& memo, const name contract = "eosio.token"_n )
+{
+    t.transfer( "myaccount"_n, "curve.sx"_n, quantity, memo, contract );
+    const auto result = profiles();
+    expect( !result.empty(), "no profile output, build with -DCURVE_PROFILE" );
+    return result[0];
+}
+
+static void setup()
+{
+    const extended_symbol A{ symbol{"A", 4}, "eosio.token"_n }, B{ symbol{"B", 4}, "eosio.token"_n }, C{ symbol{"C", 9}, "eosio.token"_n };
+
+    t.push<sx::curve::init_action>( "curve.sx"_n, "lptoken.sx"_n );
+    t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 1, "fee.sx"_n );
+    t.push<sx::curve::setstatus_action>( "curve.sx"_n, "ok"_n );
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, A, B, 20 );
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AC"}, A, C, 200 );
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"BC"}, B, C, 100 );
+    t.push<sx::curve::createpool_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"ABC"}, std::vector<extended_symbol>{ A, B, C }, 450 );
+    t.push<sx::curve::addroute_action>( "curve.sx"_n, 1, A, std::vector<symbol_code>{ symbol_code{"AB"}, symbol_code{"BC"}, symbol_code{"AC"} } );
+
+    auto deposit = [&]( const string& id, const std::vector<string>& quantities ) {
+        for ( const string& quantity : quantities ) t.transfer( "liquidity.sx"_n, "curve.sx"_n, quantity, "deposit," + id );
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{ id }, std::nullopt );
+    };
+    deposit( "AB", { "400000.0000 A", "400000.0000 B" });
+    deposit( "AC", { "100000.0000 A", "100000 C" });
+    deposit( "BC", { "100000.0000 B", "100000 C" });
+    deposit( "ABC", { "100000.0000 A", "100000.0000 B", "100000 C" });
+}
+
+int main()
+{
+    run( "setup", setup );
+
+    run( "swap 1 hop", []() {
+        const auto p = on_transfer( "10.0000 A", "swap,0,AB" );
+        expect( p.at( "swaplog" ) == 1 && p.at( "transfer" ) == 1 && p.at( "y_it" ) == 1, "unexpected counters" );
+
+        // `mul_amount` / `div_amount` calls per hop, see `curve.bench` for the cost per call
+        expect( p.at( "scale" ) == 11, "unexpected rescaling" );
+    });
+
+    run( "swap 2 hops", []() {
+        const auto p = on_transfer( "10.0000 A", "swap,0,AB-BC" );
+        expect( p.at( "swaplog" ) == 0 && p.at( "routelog" ) == 1 && p.at( "y_it" ) == 2 && p.at( "transfer" ) == 1, "unexpected counters" );
+    });
+
+    run( "swap 3 hops", []() {
+        const auto p = on_transfer( "10.0000 A", "swap,0,AB-BC-AC" );
+        expect( p.at( "swaplog" ) == 0 && p.at( "routelog" ) == 1 && p.at( "y_it" ) == 3 && p.at( "transfer" ) == 1 && p.at( "d_it" ) > 0, "unexpected counters" );
+
+        // config read once, pairs found once while parsing the memo (+1 `fees` find per hop, ramp state is in the pair row)
+        expect( p.at( "config" ) == 1 && p.at( "get" ) == 0 && p.at( "find" ) == 6, "unexpected reads" );
+    });
+
+    run( "swap 3 hops route", []() {
+        const auto p = on_transfer( "10.0000 A", "swap,0,@1" );
+        expect( p.at( "routelog" ) == 1 && p.at( "y_it" ) == 3 && p.at( "transfer" ) == 1, "unexpected counters" );
+
+        // + the `routes` row, pairs are found without parsing, duplicate or symbol chaining checks
+        expect( p.at( "config" ) == 1 && p.at( "get" ) == 1 && p.at( "find" ) == 6, "unexpected reads" );
+    });
+
+    run( "ignored transfers", []() {
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB" );
+
+        // outgoing transfers notify `curve.sx` too, they return before any table read
+        int notifications = 0, profiled = 0;
+        for ( const auto& trace : t.c.traces() ) {
+            if ( trace.receiver != "curve.sx"_n || trace.action != "transfer"_n ) continue;
+            notifications++;
+            if ( trace.console.rfind( "profile:on_transfer", 0 ) == 0 ) profiled++;
+        }
+        expect( notifications == 2 && profiled == 1, "outgoing transfers should return before profiling" );
+    });
+
+    run( "swap pool", []() {
+        const auto p = on_transfer( "10.0000 A", "swappool,0,ABC,C" );
+        expect( p.at( "swaplog" ) == 1 && p.at( "transfer" ) == 1, "unexpected counters" );
+    });
+
+    run( "deposit", []() {
+        on_transfer( "10.0000 A", "deposit,AB" );
+        on_transfer( "10.0000 B", "deposit,AB" );
+        t.push<sx::curve::deposit_action>( "myaccount"_n, "myaccount"_n, symbol_code{"AB"}, std::nullopt );
+        const auto p = profiles();
+        expect( !p.empty() && p[0].at( "issue" ) == 1 && p[0].at( "liquiditylog" ) == 1 && p[0].at( "erase" ) == 1 && p[0].at( "scale" ) == 11, "unexpected counters" );
+    });
+
+    run( "withdraw", []() {
+        const auto p = on_transfer( "1.0000 AB", "", "lptoken.sx"_n );
+        expect( p.at( "retire" ) == 1 && p.at( "transfer" ) == 2 && p.at( "liquiditylog" ) == 1, "unexpected counters" );
+    });
+
+    run( "claimfees", []() {
+        t.push<sx::curve::claimfees_action>( "myaccount"_n, "eosio.token"_n );
+        const auto p = profiles();
+        expect( !p.empty() && p[0].at( "transfer" ) == 3 && p[0].at( "modify" ) == 3, "unexpected counters" );
+    });
+
+    printf( "1..%d\n", tests );
+    return failures ? 1 : 0;
+}
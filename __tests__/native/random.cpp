@@ -0,0 +1,218 @@
+// randomized swap / deposit / withdraw sequences against the native chain
+//
+// after every transaction `curve.sx` must stay solvent (token balances cover the tracked reserves & pending orders,
+// rounding dust of mixed precision deposits stays in the contract) and each LP token supply must equal the pair (or pool) `liquidity`
+//
+// ./curve.random [sequences=20000] [seed=1]
+
+#include "fixture.hpp"
+
+#include <chrono>
+#include <map>
+#include <random>
+
+using namespace fixture;
+
+static fixture::curve t;
+static std::mt19937_64 rng;
+
+static const std::vector<string> PAIRS = { "AB", "AC", "BC", "DE" };
+static const std::vector<name> TRADERS = { "myaccount"_n, "myaccount2"_n };
+
+static std::map<string, uint64_t> rejected;
+
+static uint64_t random( const uint64_t max )
+{
+    return max ? rng() % max : 0;
+}
+
+// log-uniform fraction in [1e-6, 0.5]
+static double random_fraction()
+{
+    return 0.5 * std::pow( 10.0, -6.0 * ( rng() % 1000000 ) / 1000000.0 );
+}
+
+static void push( const std::function<string()>& fn )
+{
+    const string error = fn();
+    if ( !error.empty() ) rejected[ error ]++;
+}
+
+static string transfer( const name from, const extended_asset value, const string& memo )
+{
+    if ( value.quantity.amount <= 0 ) return "fixture: empty quantity";
+    return t.c.push_action_error( eosio::token::transfer_action{ value.contract, { from, "active"_n }}.to_action( from, "curve.sx"_n, value.quantity, memo ));
+}
+
+static extended_asset portion( const name owner, const extended_symbol sym, const double fraction )
+{
+    const asset balance = t.balance_of( owner, sym.get_symbol().code(), sym.get_contract() );
+    return extended_asset{ static_cast<int64_t>( balance.amount * fraction ), sym };
+}
+
+static void swap()
+{
+    const name trader = TRADERS[ random( TRADERS.size() ) ];
+
+    // pool swap
+    if ( random( 4 ) == 0 ) {
+        const auto pool = t.pool( "ABC" );
+        const uint64_t in = random( pool.reserves.size() );
+        const uint64_t out = ( in + 1 + random( pool.reserves.size() - 1 )) % pool.reserves.size();
+        const extended_asset quantity = portion( trader, pool.reserves[in].get_extended_symbol(), random_fraction() );
+        push( [&]() { return transfer( trader, quantity, "swappool,0,ABC," + pool.reserves[out].quantity.symbol.code().to_string() ); });
+        return;
+    }
+
+    const auto pair = t.pair( PAIRS[ random( PAIRS.size() ) ] );
+    const bool is_in = random( 2 );
+    const extended_asset reserve_in = is_in ? pair.reserve0 : pair.reserve1;
+    const extended_asset quantity = portion( trader, reserve_in.get_extended_symbol(), random_fraction() );
+    push( [&]() { return transfer( trader, quantity, "swap,0," + pair.id.to_string() ); });
+}
+
+static void deposit()
+{
+    const name owner = "liquidity.sx"_n;
+    const double fraction = random_fraction() / 10;
+
+    // pool deposit
+    if ( random( 4 ) == 0 ) {
+        for ( const auto& reserve : t.pool( "ABC" ).reserves ) {
+            push( [&]() { return transfer( owner, portion( owner, reserve.get_extended_symbol(), fraction ), "deposit,ABC" ); });
+        }
+        push( [&]() { return t.push_error<sx::curve::deposit_action>( owner, owner, symbol_code{"ABC"}, std::nullopt ); });
+        return;
+    }
+
+    // deposits are not always balanced, excess is refunded
+    const auto pair = t.pair( PAIRS[ random( PAIRS.size() ) ] );
+    const double skew = 1 + random( 100 ) / 1000.0;
+    push( [&]() { return transfer( owner, portion( owner, pair.reserve0.get_extended_symbol(), fraction ), "deposit," + pair.id.to_string() ); });
+    push( [&]() { return transfer( owner, portion( owner, pair.reserve1.get_extended_symbol(), fraction * skew ), "deposit," + pair.id.to_string() ); });
+
+    if ( random( 10 ) == 0 ) push( [&]() { return t.push_error<sx::curve::cancel_action>( owner, owner, pair.id ); });
+    else push( [&]() { return t.push_error<sx::curve::deposit_action>( owner, owner, pair.id, std::nullopt ); });
+}
+
+static void withdraw()
+{
+    const name owner = "liquidity.sx"_n;
+    const extended_symbol liquidity = random( 4 ) == 0 ? t.pool( "ABC" ).liquidity.get_extended_symbol() : t.pair( PAIRS[ random( PAIRS.size() ) ] ).liquidity.get_extended_symbol();
+    push( [&]() { return transfer( owner, portion( owner, liquidity, random_fraction() ), "" ); });
+}
+
+// `curve.sx` holds at least the reserves & pending orders, LP supplies match `liquidity`
+static void check_invariants()
+{
+    std::map<std::pair<name, symbol_code>, int64_t> expected;
+    auto add = [&]( const extended_asset& value ) {
+        expected[{ value.contract, value.quantity.symbol.code() }] += value.quantity.amount;
+    };
+    auto check_supply = [&]( const extended_asset& liquidity ) {
+        const asset supply = eosio::token::get_supply( liquidity.contract, liquidity.quantity.symbol.code() );
+        expect( supply == liquidity.quantity, liquidity.quantity.symbol.code().to_string() + " supply " + supply.to_string() + " != liquidity " + liquidity.quantity.to_string() );
+    };
+
+    sx::curve::pairs_table _pairs( "curve.sx"_n, "curve.sx"_n.value );
+    for ( const auto& pair : _pairs ) {
+        add( pair.reserve0 );
+        add( pair.reserve1 );
+        check_supply( pair.liquidity );
+        expect( pair.liquidity.quantity.amount > 0 || ( pair.reserve0.quantity.amount == 0 && pair.reserve1.quantity.amount == 0 ), pair.id.to_string() + " reserves without liquidity" );
+
+        sx::curve::orders_table _orders( "curve.sx"_n, pair.id.raw() );
+        for ( const auto& order : _orders ) {
+            add( order.quantity0 );
+            add( order.quantity1 );
+        }
+    }
+
+    sx::curve::pools_table _pools( "curve.sx"_n, "curve.sx"_n.value );
+    for ( const auto& pool : _pools ) {
+        for ( const auto& reserve : pool.reserves ) add( reserve );
+        check_supply( pool.liquidity );
+
+        sx::curve::poolorders_table _orders( "curve.sx"_n, pool.id.raw() );
+        for ( const auto& order : _orders ) {
+            for ( const auto& quantity : order.quantities ) add( quantity );
+        }
+    }
+
+    // unclaimed protocol fees
+    for ( const name contract : { "eosio.token"_n, "lptoken.sx"_n } ) {
+        sx::curve::fees_table _fees( "curve.sx"_n, contract.value );
+        for ( const auto& fee : _fees ) add( fee.balance );
+    }
+
+    for ( const auto& [ key, amount ] : expected ) {
+        const asset balance = t.balance_of( "curve.sx"_n, key.second, key.first );
+        expect( balance.amount >= amount, "curve.sx holds " + balance.to_string() + "@" + key.first.to_string() + ", expected " + std::to_string( amount ));
+    }
+}
+
+// `test.sh` state up to `liquidity.bats`, plus the ABC pool
+static void setup()
+{
+    t.push<sx::curve::init_action>( "curve.sx"_n, "lptoken.sx"_n );
+    t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 1, "fee.sx"_n );
+    t.push<sx::curve::setstatus_action>( "curve.sx"_n, "ok"_n );
+
+    const extended_symbol A{ symbol{"A", 4}, "eosio.token"_n }, B{ symbol{"B", 4}, "eosio.token"_n }, C{ symbol{"C", 9}, "eosio.token"_n };
+    const extended_symbol D{ symbol{"D", 6}, "eosio.token"_n }, E{ symbol{"E", 6}, "eosio.token"_n };
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, A, B, 20 );
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AC"}, A, C, 200 );
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"BC"}, B, C, 100 );
+    t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"DE"}, D, E, 200 );
+    t.push<sx::curve::createpool_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"ABC"}, std::vector<extended_symbol>{ A, B, C }, 450 );
+
+    auto deposit = [&]( const string& id, const std::vector<string>& quantities ) {
+        for ( const string& quantity : quantities ) t.transfer( "liquidity.sx"_n, "curve.sx"_n, quantity, "deposit," + id );
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{ id }, std::nullopt );
+    };
+    deposit( "AB", { "400000.0000 A", "400000.0000 B" });
+    deposit( "AC", { "100000.0000 A", "100000 C" });
+    deposit( "BC", { "100000.0000 B", "100000 C" });
+    deposit( "DE", { "150000000.000000 D", "150000000.000000 E" });
+    deposit( "ABC", { "100000.0000 A", "100000.0000 B", "100000 C" });
+
+    // second trader
+    for ( const string quantity : { "100000.0000 A", "100000.0000 B", "100000 C", "1000000.000000 D", "1000000.000000 E" } ) {
+        t.transfer( "myaccount"_n, "myaccount2"_n, quantity, "" );
+    }
+}
+
+int main( int argc, char** argv )
+{
+    const uint64_t sequences = argc > 1 ? std::stoull( argv[1] ) : 20000;
+    const uint64_t seed = argc > 2 ? std::stoull( argv[2] ) : 1;
+    rng.seed( seed );
+
+    uint64_t swaps = 0, deposits = 0, withdraws = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    run( "setup", setup );
+    run( std::to_string( sequences ) + " random sequences (seed " + std::to_string( seed ) + ")", [&]() {
+        check_invariants();
+        for ( uint64_t i = 0; i < sequences; ++i ) {
+            const uint64_t op = random( 10 );
+            if ( op < 6 ) { swap(); swaps++; }
+            else if ( op < 8 ) { deposit(); deposits++; }
+            else { withdraw(); withdraws++; }
+
+            try {
+                check_invariants();
+            } catch ( const failure& e ) {
+                throw failure( "sequence " + std::to_string( i ) + ": " + e.what() );
+            }
+        }
+    });
+
+    const double elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    printf( "# swaps: %llu, deposits: %llu, withdraws: %llu\n", (unsigned long long) swaps, (unsigned long long) deposits, (unsigned long long) withdraws );
+    for ( const auto& [ error, count ] : rejected ) printf( "# rejected %llu: %s\n", (unsigned long long) count, error.c_str() );
+    printf( "# %.3fs, %.0f sequences/s\n", elapsed, sequences / elapsed );
+
+    printf( "1..%d\n", tests );
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,727 @@
+// native replay of `test.sh`: config, create_pairs, liquidity, swaps, pools, ramp & withdraw scenarios
+// same steps & assertions as the `.bats` files, without `nodeos`
+
+#include "fixture.hpp"
+
+#include <random>
+
+using namespace fixture;
+
+// release builds compile `CURVE_PROFILE` out, tables stay plain `eosio::multi_index`
+static_assert( std::is_same_v<sx::curve::pairs_table, eosio::multi_index<"pairs"_n, sx::curve::pairs_row>> );
+static_assert( std::is_same_v<sx::curve::config_table, eosio::singleton<"config"_n, sx::curve::config_row>> );
+
+static fixture::curve t;
+
+static extended_symbol ext( const string& sym, const name contract )
+{
+    return extended_symbol{ sx::utils::parse_symbol( sym ), contract };
+}
+
+static string str( const int64_t value )
+{
+    return std::to_string( value );
+}
+
+// balance received by `owner` while running `fn`
+static string received( const name owner, const string& symcode, const name contract, const std::function<void()>& fn )
+{
+    const asset before = t.balance_of( owner, symbol_code{ symcode }, contract );
+    fn();
+    return ( t.balance_of( owner, symbol_code{ symcode }, contract ) - before ).to_string();
+}
+
+static string swap( const string& value, const string& memo, const string& symcode_out, const name contract_in = "eosio.token"_n, const name contract_out = "eosio.token"_n )
+{
+    return received( "myaccount"_n, symcode_out, contract_out, [&]() {
+        t.transfer( "myaccount"_n, "curve.sx"_n, value, memo, contract_in );
+    });
+}
+
+static void config()
+{
+    run( "initialized", []() {
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1000.0000 A", "" ), "under maintenance" );
+    });
+
+    run( "set config", []() {
+        t.push<sx::curve::init_action>( "curve.sx"_n, "lptoken.sx"_n );
+        t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 0, "fee.sx"_n );
+        t.push<sx::curve::setstatus_action>( "curve.sx"_n, "ok"_n );
+    });
+
+    run( "config.status = ok", []() {
+        sx::curve::config_table _config( "curve.sx"_n, "curve.sx"_n.value );
+        expect_eq( _config.get().status.to_string(), "ok" );
+    });
+}
+
+static void create_pairs()
+{
+    run( "create AB", []() {
+        t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, ext( "4,A", "eosio.token"_n ), ext( "4,B", "eosio.token"_n ), 20 );
+        expect_eq( t.pair_row( 0 ).id.to_string(), "AB" );
+    });
+
+    run( "create AC", []() {
+        t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AC"}, ext( "4,A", "eosio.token"_n ), ext( "9,C", "eosio.token"_n ), 200 );
+        expect_eq( t.pair_row( 1 ).id.to_string(), "AC" );
+    });
+
+    run( "create BC", []() {
+        t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"BC"}, ext( "4,B", "eosio.token"_n ), ext( "9,C", "eosio.token"_n ), 100 );
+        expect_eq( t.pair_row( 2 ).id.to_string(), "BC" );
+    });
+
+    run( "create CAB", []() {
+        t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"CAB"}, ext( "4,AB", "lptoken.sx"_n ), ext( "9,C", "eosio.token"_n ), 20 );
+        expect_eq( t.pair_row( 3 ).id.to_string(), "CAB" );
+    });
+
+    run( "create DE", []() {
+        t.push<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"DE"}, ext( "6,D", "eosio.token"_n ), ext( "6,E", "eosio.token"_n ), 200 );
+        expect_eq( t.pair_row( 3 ).id.to_string(), "DE" );
+    });
+
+    run( "invalid pairs", []() {
+        expect_match( t.push_error<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, ext( "4,A", "eosio.token"_n ), ext( "4,B", "eosio.token"_n ), 20 ), "already exists" );
+        expect_match( t.push_error<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, ext( "4,A", "some.token"_n ), ext( "4,B", "eosio.token"_n ), 20 ), "contract does not exists" );
+        expect_match( t.push_error<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, ext( "5,A", "eosio.token"_n ), ext( "4,B", "eosio.token"_n ), 20 ), "symbol mismatch" );
+        expect_match( t.push_error<sx::curve::createpair_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AD"}, ext( "4,A", "eosio.token"_n ), ext( "6,D", "eosio.token"_n ), 2000000 ), "invalid amplifier" );
+    });
+}
+
+static void liquidity()
+{
+    run( "deposit AB", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( AB_LIQ ) + ".0000 A", "deposit,AB" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( AB_LIQ ) + ".0000 B", "deposit,AB" );
+
+        expect_eq( t.order( "AB", "liquidity.sx"_n ).quantity0.quantity.to_string(), str( AB_LIQ ) + ".0000 A" );
+        expect_eq( t.order( "AB", "liquidity.sx"_n ).quantity1.quantity.to_string(), str( AB_LIQ ) + ".0000 B" );
+
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AB"}, std::nullopt );
+
+        expect_eq( t.pair( "AB" ).reserve0.quantity.to_string(), str( AB_LIQ ) + ".0000 A" );
+        expect_eq( t.pair( "AB" ).reserve1.quantity.to_string(), str( AB_LIQ ) + ".0000 B" );
+        expect_eq( t.pair( "AB" ).liquidity.quantity.to_string(), str( 2 * AB_LIQ ) + ".0000 AB" );
+        expect_eq( str( t.pair( "AB" ).invariant.value() ), str( 2 * AB_LIQ ) + "000000" );
+        expect_eq( t.balance( "liquidity.sx"_n, "AB", "lptoken.sx"_n ), str( 2 * AB_LIQ ) + ".0000 AB" );
+    });
+
+    run( "deposit with excess BC", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( BC_LIQ + 100 ) + ".0000 B", "deposit,BC" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( BC_LIQ ) + ".000000000 C", "deposit,BC" );
+
+        expect_eq( t.order( "BC", "liquidity.sx"_n ).quantity0.quantity.to_string(), str( BC_LIQ + 100 ) + ".0000 B" );
+        expect_eq( t.order( "BC", "liquidity.sx"_n ).quantity1.quantity.to_string(), str( BC_LIQ ) + ".000000000 C" );
+        expect_eq( t.balance( "liquidity.sx"_n, "B" ), str( B_LP_TOTAL - AB_LIQ - BC_LIQ - 100 ) + ".0000 B" );
+
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"BC"}, std::nullopt );
+
+        expect_eq( t.balance( "liquidity.sx"_n, "B" ), str( B_LP_TOTAL - AB_LIQ - BC_LIQ ) + ".0000 B" );
+        expect_eq( t.pair( "BC" ).reserve0.quantity.to_string(), str( BC_LIQ ) + ".0000 B" );
+        expect_eq( t.pair( "BC" ).reserve1.quantity.to_string(), str( BC_LIQ ) + ".000000000 C" );
+        expect_eq( t.pair( "BC" ).liquidity.quantity.to_string(), str( 2 * BC_LIQ ) + ".000000000 BC" );
+        expect_eq( t.balance( "liquidity.sx"_n, "BC", "lptoken.sx"_n ), str( 2 * BC_LIQ ) + ".000000000 BC" );
+    });
+
+    run( "deposit AC", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( AC_LIQ ) + ".0000 A", "deposit,AC" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( AC_LIQ ) + ".000000000 C", "deposit,AC" );
+
+        expect_eq( t.order( "AC", "liquidity.sx"_n ).quantity0.quantity.to_string(), str( AC_LIQ ) + ".0000 A" );
+        expect_eq( t.order( "AC", "liquidity.sx"_n ).quantity1.quantity.to_string(), str( AC_LIQ ) + ".000000000 C" );
+
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AC"}, std::nullopt );
+
+        expect_eq( t.pair( "AC" ).reserve0.quantity.to_string(), str( AC_LIQ ) + ".0000 A" );
+        expect_eq( t.pair( "AC" ).reserve1.quantity.to_string(), str( AC_LIQ ) + ".000000000 C" );
+        expect_eq( t.pair( "AC" ).liquidity.quantity.to_string(), str( 2 * AC_LIQ ) + ".000000000 AC" );
+        expect_eq( t.balance( "liquidity.sx"_n, "C" ), str( C_LP_TOTAL - AC_LIQ - BC_LIQ ) + ".000000000 C" );
+        expect_eq( t.balance( "liquidity.sx"_n, "AC", "lptoken.sx"_n ), str( 2 * AC_LIQ ) + ".000000000 AC" );
+    });
+
+    run( "invalid deposits", []() {
+        const string a_balance = t.balance( "liquidity.sx"_n, "A" );
+
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "1000.0000 A", "deposit,AC" );
+        expect_match( t.transfer_error( "liquidity.sx"_n, "curve.sx"_n, "1000.0000 A", "deposit,ABB" ), "does not exist" );
+        expect_match( t.push_error<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AC"}, std::nullopt ), "one of the deposit is empty" );
+        expect_match( t.push_error<sx::curve::deposit_action>( "myaccount"_n, "myaccount"_n, symbol_code{"AC"}, std::nullopt ), "no deposits available for this user" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "deposit,AC" ), "invalid extended symbol" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1000.0000 A", "deposit,AB", "fake.token"_n ), "invalid extended symbol" );
+        expect_match( t.push_error<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"BC"}, std::nullopt ), "no deposits available for this user" );
+        expect_match( t.push_error<sx::curve::cancel_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AB"} ), "no deposits for this user in this pool" );
+        t.push<sx::curve::cancel_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AC"} );
+
+        expect_eq( t.balance( "liquidity.sx"_n, "A" ), a_balance );
+    });
+
+    run( "withdraw half AC", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( AC_LIQ ) + ".0000 AC", "", "lptoken.sx"_n );
+
+        expect_eq( t.balance( "liquidity.sx"_n, "A" ), str( A_LP_TOTAL - AB_LIQ - AC_LIQ / 2 ) + ".0000 A" );
+        expect_eq( t.balance( "liquidity.sx"_n, "AC", "lptoken.sx"_n ), str( AC_LIQ ) + ".000000000 AC" );
+        expect_eq( t.pair( "AC" ).liquidity.quantity.to_string(), str( AC_LIQ ) + ".000000000 AC" );
+        expect_eq( t.pair( "AC" ).reserve0.quantity.to_string(), str( AC_LIQ / 2 ) + ".0000 A" );
+        expect_eq( t.pair( "AC" ).reserve1.quantity.to_string(), str( AC_LIQ / 2 ) + ".000000000 C" );
+    });
+
+    run( "deposit CAB", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( CAB_LIQ ) + ".000000000 C", "deposit,CAB" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( CAB_LIQ ) + ".0000 AB", "deposit,CAB", "lptoken.sx"_n );
+
+        expect_eq( t.order( "CAB", "liquidity.sx"_n ).quantity0.quantity.to_string(), str( CAB_LIQ ) + ".0000 AB" );
+        expect_eq( t.order( "CAB", "liquidity.sx"_n ).quantity1.quantity.to_string(), str( CAB_LIQ ) + ".000000000 C" );
+
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"CAB"}, std::nullopt );
+
+        expect_eq( t.pair( "CAB" ).reserve0.quantity.to_string(), str( CAB_LIQ ) + ".0000 AB" );
+        expect_eq( t.pair( "CAB" ).reserve1.quantity.to_string(), str( CAB_LIQ ) + ".000000000 C" );
+        expect_eq( t.pair( "CAB" ).liquidity.quantity.to_string(), str( 2 * CAB_LIQ ) + ".000000000 CAB" );
+        expect_eq( t.balance( "liquidity.sx"_n, "C" ), str( C_LP_TOTAL - AC_LIQ / 2 - BC_LIQ - CAB_LIQ ) + ".000000000 C" );
+        expect_eq( t.balance( "liquidity.sx"_n, "CAB", "lptoken.sx"_n ), str( 2 * CAB_LIQ ) + ".000000000 CAB" );
+    });
+
+    run( "deposit DE", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( DE_LIQ ) + ".000000 D", "deposit,DE" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, str( DE_LIQ ) + ".000000 E", "deposit,DE" );
+
+        expect_eq( t.order( "DE", "liquidity.sx"_n ).quantity0.quantity.to_string(), str( DE_LIQ ) + ".000000 D" );
+        expect_eq( t.order( "DE", "liquidity.sx"_n ).quantity1.quantity.to_string(), str( DE_LIQ ) + ".000000 E" );
+
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"DE"}, std::nullopt );
+
+        expect_eq( t.pair( "DE" ).reserve0.quantity.to_string(), str( DE_LIQ ) + ".000000 D" );
+        expect_eq( t.pair( "DE" ).reserve1.quantity.to_string(), str( DE_LIQ ) + ".000000 E" );
+        expect_eq( t.pair( "DE" ).liquidity.quantity.to_string(), str( 2 * DE_LIQ ) + ".000000 DE" );
+        expect_eq( t.balance( "liquidity.sx"_n, "DE", "lptoken.sx"_n ), str( 2 * DE_LIQ ) + ".000000 DE" );
+    });
+
+    run( "deposit slippage protection", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "1.0000 A", "deposit,AB" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "1.0000 B", "deposit,AB" );
+
+        expect_match( t.push_error<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AB"}, 9999999999 ), "deposit amount must exceed" );
+        t.push<sx::curve::cancel_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"AB"} );
+    });
+}
+
+static void swaps()
+{
+    run( "sample swaps", []() {
+        expect_eq( t.balance( "myaccount"_n, "A" ), "1000000.0000 A" );
+        expect_eq( t.balance( "myaccount"_n, "B" ), "1000000.0000 B" );
+        expect_eq( t.balance( "myaccount"_n, "C" ), "1000000.000000000 C" );
+        expect_eq( t.balance( "myaccount"_n, "D" ), "10000000.000000 D" );
+        expect_eq( t.balance( "myaccount"_n, "E" ), "10000000.000000 E" );
+
+        expect_eq( swap( "100.0000 A", "swap,0,AB", "B" ), "99.9594 B" );
+        expect_eq( swap( "10000.0000 A", "swap,0,AB", "B" ), "9989.9337 B" );
+        expect_eq( swap( "1000.0000 A", "swap,0,AB", "B" ), "998.3396 B" );
+        expect_eq( swap( "1000 C", "swap,0,CAB", "AB", "eosio.token"_n, "lptoken.sx"_n ), "999.1241 AB" );
+        expect_eq( swap( "900 AB", "swap,0,CAB", "C", "lptoken.sx"_n ), "900.110930000 C" );
+        expect_eq( swap( "100.0000 A", "swap,0,AB-BC", "C" ), "99.786484000 C" );
+        expect_eq( swap( "100.000000 D", "swap,0,DE", "E" ), "99.960000 E" );
+    });
+
+    // `swaps.bats` expects "contract mismatch", the contract reports these as "invalid extended symbol"
+    run( "invalid transfers", []() {
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,BA" ), "does not exist" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,900000,AC-BC" ), "invalid extended symbol" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,0,AB-BC" ), "invalid extended symbol" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,1200000,AB" ), "invalid minimum return" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,900000,   AB" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,900000,AB,FOO" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,900000,AB,foo" ), "to account does not exist" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "foo,0,AC" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AB", "fake.token"_n ), "invalid extended symbol" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.00000000 C", "swap,900000,AC-AC" ), "invalid duplicate" );
+    });
+
+    run( "valid transfers", []() {
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AB" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,0,AB" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 B", "swap,900000,AB" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,900000,AB" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,90000000000,AC" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.00000000 C", "swap,900000,AC-AB" );
+
+        // multi-hop routes log every hop in one `routelog`
+        expect( t.c.actions<&sx::curve::swaplog>().empty(), "unexpected swaplog" );
+        const auto logs = t.c.actions<&sx::curve::routelog>();
+        expect( logs.size() == 1, "expected 1 routelog, got " + str( logs.size() ) );
+        const auto& hops = std::get<2>( logs[0] );
+        expect( hops.size() == 2, "expected 2 hops, got " + str( hops.size() ) );
+        expect_eq( hops[0].pair_id.to_string(), "AC" );
+        expect_eq( hops[1].pair_id.to_string(), "AB" );
+        expect_eq( hops[0].quantity_in.to_string(), "100.000000000 C" );
+        expect( hops[0].quantity_out == hops[1].quantity_in, "hops are not chained" );
+        expect( hops[1].reserve0 == t.pair( "AB" ).reserve0.quantity && hops[1].reserve1 == t.pair( "AB" ).reserve1.quantity, "hop reserves" );
+    });
+
+    run( "swap with protocol fee", []() {
+        t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 1, "fee.sx"_n );
+        expect_eq( t.balance( "fee.sx"_n, "A" ), "" );
+
+        expect_eq( swap( "1000.0000 A", "swap,0,AB", "B" ), "998.0972 B" );
+        expect_eq( swap( "1000.0000 B", "swap,0,AB", "A" ), "1000.9047 A" );
+        expect_eq( swap( "1000.0000 C", "swap,0,CAB", "AB", "eosio.token"_n, "lptoken.sx"_n ), "998.9296 AB" );
+        expect_eq( swap( "1000.000000 D", "swap,0,DE", "E" ), "999.500001 E" );
+        expect_eq( swap( "1000.0000 AB", "swap,0,CAB", "C", "lptoken.sx"_n ), "1000.070291000 C" );
+
+        // protocol fees accrue until claimed
+        expect_eq( t.balance( "fee.sx"_n, "A" ), "" );
+        sx::curve::fees_table _fees( "curve.sx"_n, "eosio.token"_n.value );
+        expect_eq( _fees.get( symbol_code{"A"}.raw() ).balance.quantity.to_string(), "0.1000 A" );
+
+        t.push<sx::curve::claimfees_action>( "myaccount"_n, "eosio.token"_n );
+        t.push<sx::curve::claimfees_action>( "myaccount"_n, "lptoken.sx"_n );
+        expect_match( t.push_error<sx::curve::claimfees_action>( "myaccount"_n, "eosio.token"_n ), "no fees to claim" );
+        expect_eq( _fees.get( symbol_code{"A"}.raw() ).balance.quantity.to_string(), "0.0000 A" );
+
+        expect_eq( t.balance( "fee.sx"_n, "A" ), "0.1000 A" );
+        expect_eq( t.balance( "fee.sx"_n, "B" ), "0.1000 B" );
+        expect_eq( t.balance( "fee.sx"_n, "C" ), "0.100000000 C" );
+        expect_eq( t.balance( "fee.sx"_n, "D" ), "0.100000 D" );
+        expect_eq( t.balance( "fee.sx"_n, "AB", "lptoken.sx"_n ), "0.1000 AB" );
+
+        t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 0, "fee.sx"_n );
+    });
+
+    // `pairs` stores D in reserve0/reserve1 order, swaps from reserve1 re-solve it in input/output order (`formula.bats` #10)
+    run( "reverse swap quote", []() {
+        sx::curve::pairs_row row;
+        row.reserve0 = { asset{ 10607069950, symbol{"X", 6} }, "eosio.token"_n };
+        row.reserve1 = { asset{ 85692935855, symbol{"Y", 6} }, "eosio.token"_n };
+        row.amplifier = 22;
+        sx::curve::update_invariant( row );
+        sx::curve::config_row config;
+        config.trade_fee = 4;
+        expect_eq( sx::curve::get_amount_out( asset{ 5889684945, symbol{"Y", 6} }, row, config, 22 ).to_string(), "3683.332307 X" );
+    });
+
+    // rows created before `invariant` was stored have no value, D is recalculated until the next trade stores it
+    run( "pair without stored invariant", []() {
+        const asset in = t.quantity( "eosio.token"_n, "10.0000 A" );
+        const asset quote = sx::curve::get_amount_out( in, symbol_code{"AB"}, "curve.sx"_n );
+        t.legacy_pair( "AB" ).invariant.reset();
+        t.legacy_pair( "AB" ).invariant_amplifier.reset();
+
+        expect_eq( sx::curve::get_amount_out( in, symbol_code{"AB"}, "curve.sx"_n ).to_string(), quote.to_string() );
+        expect_eq( received( "myaccount"_n, "B", "eosio.token"_n, []() {
+            t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB" );
+        }), quote.to_string() );
+        expect( t.pair( "AB" ).invariant.has_value() && t.pair( "AB" ).invariant_amplifier.value() == t.pair( "AB" ).amplifier, "invariant not stored on first touch" );
+    });
+
+    run( "swap exact output", []() {
+        t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 1, "fee.sx"_n );
+
+        // single hop: receive exactly the quoted input's output, unused input is refunded
+        const asset required = sx::curve::get_amount_in( asset{ 1000'0000, symbol{"B", 4} }, symbol_code{"AB"}, "curve.sx"_n );
+        const asset before = t.balance_of( "myaccount"_n, symbol_code{"A"}, "eosio.token"_n );
+        expect_eq( received( "myaccount"_n, "B", "eosio.token"_n, []() {
+            t.transfer( "myaccount"_n, "curve.sx"_n, "2000.0000 A", "swapout,10000000,AB" );
+        }), "1000.0000 B" );
+        expect_eq( ( before - t.balance_of( "myaccount"_n, symbol_code{"A"}, "eosio.token"_n ) ).to_string(), required.to_string() );
+        expect( std::get<3>( t.c.actions<&sx::curve::swaplog>()[0] ) == required, "swaplog quantity_in" );
+
+        // multi-hop: required input is calculated backwards across all hops
+        const asset out = asset{ 100'000000000, symbol{"C", 9} };
+        const asset hop_in = sx::curve::get_amount_in( out, symbol_code{"BC"}, "curve.sx"_n );
+        const asset route_in = sx::curve::get_amount_in( hop_in, symbol_code{"AB"}, "curve.sx"_n );
+        const asset a0 = t.balance_of( "myaccount"_n, symbol_code{"A"}, "eosio.token"_n );
+        const asset c0 = t.balance_of( "myaccount"_n, symbol_code{"C"}, "eosio.token"_n );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "500.0000 A", "swapout,100000000000,AB-BC" );
+        expect( t.balance_of( "myaccount"_n, symbol_code{"C"}, "eosio.token"_n ) - c0 >= out, "received less than `amount_out`" );
+        expect_eq( ( a0 - t.balance_of( "myaccount"_n, symbol_code{"A"}, "eosio.token"_n ) ).to_string(), route_in.to_string() );
+
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swapout,1000000000,AB" ), "insufficient input, requires" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swapout,0,AB" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swapout,100,BC" ), "invalid extended symbol" );
+
+        t.push<sx::curve::setfee_action>( "curve.sx"_n, 4, 0, "fee.sx"_n );
+    });
+
+    run( "notifiers", []() {
+        expect_match( t.push_error<sx::curve::setnotifiers_action>( "curve.sx"_n, std::vector<name>{ "nobody"_n } ), "does not exist" );
+        expect_match( t.push_error<sx::curve::setnotifiers_action>( "curve.sx"_n, std::vector<name>{ "fee.sx"_n, "fee.sx"_n } ), "duplicate" );
+        t.push<sx::curve::setnotifiers_action>( "curve.sx"_n, std::vector<name>{ "fee.sx"_n } );
+
+        // notifications received by `fee.sx` per action name
+        auto notified = []() {
+            std::map<name, int> result;
+            for ( const auto& trace : t.c.traces() ) {
+                if ( trace.receiver == "fee.sx"_n ) result[ trace.action ]++;
+            }
+            return result;
+        };
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB" );
+        auto n = notified();
+        expect( n["transfer"_n] == 1 && n["swaplog"_n] == 1, "notifiers not notified" );
+
+        // `on_transfer` keeps notifying, log actions no longer do
+        t.push<sx::curve::setlognotify_action>( "curve.sx"_n, false );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB-BC" );
+        n = notified();
+        expect( n["transfer"_n] == 1 && n["routelog"_n] == 0, "log actions should not notify" );
+
+        // standalone `deposit` & pair subscribers are still notified of logs
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "deposit,AB" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 B", "deposit,AB" );
+        t.push<sx::curve::deposit_action>( "myaccount"_n, "myaccount"_n, symbol_code{"AB"}, std::nullopt );
+        expect( notified()["liquiditylog"_n] == 1, "deposit log should notify" );
+        t.push<sx::curve::subscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"BC"} );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB-BC" );
+        expect( notified()["routelog"_n] == 1, "subscriber should be notified of logs" );
+        t.push<sx::curve::unsubscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"BC"} );
+
+        t.push<sx::curve::setlognotify_action>( "curve.sx"_n, true );
+        t.push<sx::curve::setnotifiers_action>( "curve.sx"_n, std::vector<name>{} );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB" );
+        expect( notified().empty(), "notifiers not cleared" );
+    });
+
+    run( "subscribers", []() {
+        expect_match( t.push_error<sx::curve::subscribe_action>( "curve.sx"_n, "nobody"_n, symbol_code{"BC"} ), "does not exist" );
+        expect_match( t.push_error<sx::curve::subscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"XY"} ), "`pair_id` does not exist" );
+        t.push<sx::curve::subscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"BC"} );
+        expect_match( t.push_error<sx::curve::subscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"BC"} ), "already subscribed" );
+
+        // actions notified to `account`
+        auto notified = []( const name account ) {
+            std::map<name, int> result;
+            for ( const auto& trace : t.c.traces() ) {
+                if ( trace.receiver == account ) result[ trace.action ]++;
+            }
+            return result;
+        };
+
+        // only swaps & liquidity changes involving `BC`
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB" );
+        expect( notified( "fee.sx"_n ).empty(), "notified of another pair" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB-BC" );
+        auto n = notified( "fee.sx"_n );
+        expect( n["transfer"_n] == 1 && n["routelog"_n] == 1, "subscriber not notified of the route" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 B", "deposit,BC" );
+        expect( notified( "fee.sx"_n )["transfer"_n] == 1, "subscriber not notified of the deposit" );
+        t.push<sx::curve::cancel_action>( "myaccount"_n, "myaccount"_n, symbol_code{"BC"} );
+
+        // wildcard
+        t.push<sx::curve::subscribe_action>( "curve.sx"_n, "myaccount2"_n, symbol_code{} );
+        sx::curve::config_table _config( "curve.sx"_n, "curve.sx"_n.value );
+        expect( _config.get().notifiers == std::vector<name>{ "myaccount2"_n }, "wildcard not in notifiers" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB" );
+        expect( notified( "myaccount2"_n )["swaplog"_n] == 1 && notified( "fee.sx"_n ).empty(), "wildcard subscriber not notified" );
+
+        t.push<sx::curve::unsubscribe_action>( "curve.sx"_n, "myaccount2"_n, symbol_code{} );
+        t.push<sx::curve::unsubscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"BC"} );
+        expect_match( t.push_error<sx::curve::unsubscribe_action>( "curve.sx"_n, "fee.sx"_n, symbol_code{"BC"} ), "not subscribed" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB-BC" );
+        expect( notified( "fee.sx"_n ).empty() && notified( "myaccount2"_n ).empty(), "unsubscribed notifiers notified" );
+    });
+
+    // `parse_memo` tokens are `string_view`s: empty tokens are skipped like `sx::utils::split`
+    run( "memo tokens", []() {
+        expect( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", ",swap,,0,AB-" ).empty(), "empty tokens should be skipped" );
+        expect( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "swap,0,-AB--BC" ).empty(), "empty pair ids should be skipped" );
+        expect( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "swap,00000000000000000000001,AB" ).empty(), "leading zeros" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "swap,9223372036854775808,AB" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "swap,-1,AB" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "swap,0" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "deposit" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "1.0000 A", "swap,0,AB-BC-AB" ), "invalid duplicate" );
+    });
+
+    run( "registered routes", []() {
+        const extended_symbol A = ext( "4,A", "eosio.token"_n ), B = ext( "4,B", "eosio.token"_n );
+        using route = std::vector<symbol_code>;
+        expect_match( t.push_error<sx::curve::addroute_action>( "curve.sx"_n, 1, A, route{ symbol_code{"BC"} } ), "invalid extended symbol" );
+        expect_match( t.push_error<sx::curve::addroute_action>( "curve.sx"_n, 1, A, route{ symbol_code{"AB"}, symbol_code{"AB"} } ), "invalid duplicate" );
+        expect_match( t.push_error<sx::curve::addroute_action>( "curve.sx"_n, 1, A, route{ symbol_code{"BA"} } ), "does not exist" );
+        expect_match( t.push_error<sx::curve::addroute_action>( "curve.sx"_n, 1, A, route{} ), "invalid `pair_ids` size" );
+
+        t.push<sx::curve::addroute_action>( "curve.sx"_n, 1, A, route{ symbol_code{"AB"}, symbol_code{"BC"} } );
+        t.push<sx::curve::addroute_action>( "curve.sx"_n, 2, B, route{ symbol_code{"AB"} } );
+        expect_match( t.push_error<sx::curve::addroute_action>( "curve.sx"_n, 1, A, route{ symbol_code{"AB"} } ), "already exists" );
+        sx::curve::routes_table _routes( "curve.sx"_n, "curve.sx"_n.value );
+        expect( _routes.get( 1 ).out == ext( "9,C", "eosio.token"_n ), "route output" );
+
+        // same return as the memo `pair_ids`
+        const asset hop = sx::curve::get_amount_out( asset{ 10'0000, symbol{"A", 4} }, symbol_code{"AB"}, "curve.sx"_n );
+        const asset out = sx::curve::get_amount_out( hop, symbol_code{"BC"}, "curve.sx"_n );
+        expect_eq( received( "myaccount"_n, "C", "eosio.token"_n, []() {
+            t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,@1" );
+        }), out.to_string() );
+        expect( std::get<2>( t.c.actions<&sx::curve::routelog>()[0] ).size() == 2, "routelog hops" );
+        const asset back = sx::curve::get_amount_out( asset{ 10'0000, symbol{"B", 4} }, symbol_code{"AB"}, "curve.sx"_n );
+        expect_eq( received( "myaccount"_n, "A", "eosio.token"_n, []() {
+            t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 B", "swap,0,@2" );
+        }), back.to_string() );
+        expect( t.transfer_error( "myaccount"_n, "curve.sx"_n, "500.0000 A", "swapout,100000000000,@1" ).empty(), "swapout via route" );
+
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 B", "swap,0,@1" ), "invalid extended symbol" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,@1", "fake.token"_n ), "invalid extended symbol" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,@9" ), "`route_id` does not exist" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,@x" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,100000000000,@1" ), "invalid minimum return" );
+
+        t.push<sx::curve::delroute_action>( "curve.sx"_n, 2 );
+        expect_match( t.push_error<sx::curve::delroute_action>( "curve.sx"_n, 2 ), "does not exist" );
+    });
+
+    run( "swap to recipient", []() {
+        // output paid to `liquidity.sx` with the rest of the memo (commas included), nothing back to the sender
+        const asset out = sx::curve::get_amount_out( asset{ 10'0000, symbol{"A", 4} }, symbol_code{"AB"}, "curve.sx"_n );
+        expect_eq( received( "myaccount"_n, "B", "eosio.token"_n, [&]() {
+            expect_eq( received( "liquidity.sx"_n, "B", "eosio.token"_n, []() {
+                t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB,liquidity.sx,order,123" );
+            }), out.to_string() );
+        }), "0.0000 B" );
+        const auto transfers = t.c.actions<&eosio::token::transfer>();
+        expect_eq( std::get<3>( transfers.back() ), "order,123" );
+        expect( std::get<0>( t.c.actions<&sx::curve::swaplog>()[0] ) == symbol_code{"AB"} && std::get<1>( t.c.actions<&sx::curve::swaplog>()[0] ) == "myaccount"_n, "swaplog owner" );
+
+        // default memo, multi-hop & registered routes
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB-BC,liquidity.sx" );
+        expect_eq( std::get<3>( t.c.actions<&eosio::token::transfer>().back() ), "curve.sx: swap token" );
+        expect( std::get<1>( t.c.actions<&eosio::token::transfer>().back() ) == "liquidity.sx"_n, "route recipient" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,@1,liquidity.sx,route" );
+        expect_eq( std::get<3>( t.c.actions<&eosio::token::transfer>().back() ), "route" );
+
+        // exact output: refund to the sender, output to the recipient
+        const string refund = received( "myaccount"_n, "A", "eosio.token"_n, []() {
+            expect_eq( received( "liquidity.sx"_n, "B", "eosio.token"_n, []() {
+                t.transfer( "myaccount"_n, "curve.sx"_n, "20.0000 A", "swapout,100000,AB,liquidity.sx" );
+            }), "10.0000 B" );
+        });
+        expect( refund != "-20.0000 A", "unused input should be refunded to the sender" );
+
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swap,0,AB,Bad" ), "invalid memo" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "10.0000 A", "swappool,0,ABC,C,liquidity.sx" ), "invalid memo" );
+    });
+
+    run( "50 random swaps", []() {
+        const string symbols = "ABCDE";
+        const std::vector<string> pairs = { "AB", "BC", "AC", "DE" };
+        std::mt19937 rng( 50 );
+
+        for ( int i = 0; i <= 50; ++i ) {
+            const string curr1( 1, symbols[ rng() % symbols.size() ] );
+            string decimals = str( rng() % 10000 );
+            if ( curr1 == "C" ) decimals = str( rng() % 10000 ) + "8" + str( rng() % 10000 );
+            if ( curr1 == "D" || curr1 == "E" ) decimals = str( rng() % 10000 ) + "12";
+
+            string pair = pairs[ rng() % pairs.size() ];
+            while ( pair.find( curr1 ) == string::npos ) pair = pairs[ rng() % pairs.size() ];
+
+            const string tokens = str( rng() % 32768 ) + "." + decimals + " " + curr1;
+            const string error = t.transfer_error( "myaccount"_n, "curve.sx"_n, tokens, "swap,0," + pair );
+            expect( error.empty(), "swapping " + tokens + " => " + pair + ": " + error );
+        }
+    });
+
+    run( "solver stats", []() {
+        const string output = t.push_error<sx::curve::solverstats_action>( "curve.sx"_n, symbol_code{"AB"}, t.quantity( "eosio.token"_n, "100.0000 A" ) );
+        expect_match( output, "d_iterations=0" );
+        expect_match( output, "y_iterations=1" );
+        expect_match( output, "delta=0" );
+        expect_match( output, "is_wide=0" );
+    });
+}
+
+static void pools()
+{
+    const std::vector<extended_symbol> abc = { ext( "4,A", "eosio.token"_n ), ext( "4,B", "eosio.token"_n ), ext( "9,C", "eosio.token"_n ) };
+
+    run( "create ABC pool", [&]() {
+        t.push<sx::curve::createpool_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"ABC"}, abc, 450 );
+        expect_eq( t.pool( "ABC" ).id.to_string(), "ABC" );
+    });
+
+    run( "invalid pools", [&]() {
+        expect_match( t.push_error<sx::curve::createpool_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"ABD"}, std::vector<extended_symbol>{ abc[0], abc[1] }, 450 ), "invalid number of reserves" );
+        expect_match( t.push_error<sx::curve::createpool_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AAC"}, std::vector<extended_symbol>{ abc[0], abc[0], abc[2] }, 450 ), "invalid duplicate reserves" );
+        expect_match( t.push_error<sx::curve::createpool_action>( "curve.sx"_n, "curve.sx"_n, symbol_code{"AB"}, abc, 450 ), "already exists" );
+    });
+
+    run( "deposit ABC", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "10000.0000 A", "deposit,ABC" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "10000.0000 B", "deposit,ABC" );
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "10000.000000000 C", "deposit,ABC" );
+
+        sx::curve::poolorders_table _orders( "curve.sx"_n, symbol_code{"ABC"}.raw() );
+        expect_eq( _orders.get( "liquidity.sx"_n.value ).quantities[2].quantity.to_string(), "10000.000000000 C" );
+
+        t.push<sx::curve::deposit_action>( "liquidity.sx"_n, "liquidity.sx"_n, symbol_code{"ABC"}, std::nullopt );
+
+        expect_eq( t.pool( "ABC" ).liquidity.quantity.to_string(), "30000.000000000 ABC" );
+        expect_eq( str( t.pool( "ABC" ).invariant ), "30000000000" );
+        expect_eq( t.balance( "liquidity.sx"_n, "ABC", "lptoken.sx"_n ), "30000.000000000 ABC" );
+    });
+
+    run( "swap ABC", []() {
+        expect_eq( swap( "100.0000 A", "swappool,0,ABC,C", "C" ), "99.957784000 C" );
+        expect_eq( swap( "100.000000000 C", "swappool,0,ABC,B", "B" ), "99.9600 B" );
+    });
+
+    run( "invalid pool swaps", []() {
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swappool,0,ABC,A" ), "input and output reserves must be different" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swappool,0,XYZ,C" ), "does not exist" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swappool,100000000000,ABC,C" ), "invalid minimum return" );
+        expect_match( t.transfer_error( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AB,C" ), "invalid memo" );
+    });
+
+    run( "withdraw ABC", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, "3000.000000000 ABC", "", "lptoken.sx"_n );
+        expect_eq( t.pool( "ABC" ).liquidity.quantity.to_string(), "27000.000000000 ABC" );
+    });
+}
+
+// `ramp.bats` skips the ramps under the production `MIN_RAMP_TIME`, the native chain can fast-forward instead
+static void ramp()
+{
+    run( "invalid ramp", []() {
+        expect_match( t.push_error<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AB"}, 0, 1 ), "target amplifier should be" );
+        expect_match( t.push_error<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AB"}, 2000000, 1 ), "target amplifier should be" );
+        expect_match( t.push_error<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AB"}, 100, 0 ), "should be above" );
+        expect_match( t.push_error<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AD"}, 100, 0 ), "does not exist in" );
+        expect_match( t.push_error<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AB"}, 200, 1 ), to_string( MIN_RAMP_TIME ) + " seconds" );
+    });
+
+    run( "ramp AB amplifier 20->200", []() {
+        const uint64_t amp_start = t.pair( "AB" ).amplifier;
+        t.push<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AB"}, 200, MIN_RAMP_TIME / 60 );
+        expect( t.pair( "AB" ).amplifier == amp_start, "amplifier changed before any trade" );
+
+        t.c.produce_block( eosio::hours( 1 ));
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AB" );
+        expect( t.pair( "AB" ).amplifier != amp_start, "amplifier did not ramp" );
+    });
+
+    run( "ramp AC amplifier 200->100", []() {
+        const uint64_t amp_start = t.pair( "AC" ).amplifier;
+        t.push<sx::curve::ramp_action>( "curve.sx"_n, symbol_code{"AC"}, 100, MIN_RAMP_TIME / 60 );
+        expect( t.pair( "AC" ).amplifier == amp_start, "amplifier changed before any trade" );
+
+        t.c.produce_block( eosio::hours( 1 ));
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AC" );
+        expect( t.pair( "AC" ).amplifier != amp_start, "amplifier did not ramp" );
+    });
+
+    run( "stop ramp", []() {
+        expect( t.pair( "AB" ).ramp_target_amplifier.value() == 200, "no ramp set" );
+
+        expect_match( t.push_error<sx::curve::stopramp_action>( "curve.sx"_n, symbol_code{"BC"} ), "no active ramp" );
+        const uint64_t amplifier = sx::curve::get_amplifier( t.pair( "AB" ));
+        t.push<sx::curve::stopramp_action>( "curve.sx"_n, symbol_code{"AB"} );
+        expect( t.pair( "AB" ).ramp_end_time.value() == time_point_sec{}, "AB ramp not removed" );
+        expect( t.pair( "AB" ).amplifier == amplifier, "AB amplifier not kept at the current value" );
+        expect( t.pair( "AC" ).ramp_end_time.value() != time_point_sec{}, "AC ramp removed" );
+    });
+
+    run( "ramp ends", []() {
+        // once ended, the next trade stores the target amplifier & clears the ramp state
+        t.c.produce_block( eosio::seconds( MIN_RAMP_TIME ));
+        expect( sx::curve::get_amplifier( t.pair( "AC" )) == 100, "AC ramp not reached" );
+        t.transfer( "myaccount"_n, "curve.sx"_n, "100.0000 A", "swap,0,AC" );
+        expect( t.pair( "AC" ).amplifier == 100 && t.pair( "AC" ).ramp_end_time.value() == time_point_sec{}, "AC ramp not finalized" );
+    });
+
+    // rows created before ramps were stored in `pairs` have no ramp fields, `migrate` moves the legacy `ramp` rows into them
+    run( "migrate legacy ramps", []() {
+        const time_point_sec now = eosio::current_time_point();
+        const uint64_t amp_bc = t.pair( "BC" ).amplifier;
+        const uint64_t amp_de = t.pair( "DE" ).amplifier;
+        for ( const string pair_id : { "BC", "DE" } ) {
+            auto& row = t.legacy_pair( pair_id );
+            row.invariant.reset();
+            row.invariant_amplifier.reset();
+            row.ramp_start_amplifier.reset();
+            row.ramp_target_amplifier.reset();
+            row.ramp_start_time.reset();
+            row.ramp_end_time.reset();
+        }
+        t.legacy_ramp({ symbol_code{"BC"}, amp_bc, amp_bc * 2, now, now + MIN_RAMP_TIME });
+        t.legacy_ramp({ symbol_code{"DE"}, amp_de, amp_de + 1, now - 2 * MIN_RAMP_TIME, now - MIN_RAMP_TIME });
+        t.legacy_ramp({ symbol_code{"AB"}, 1, 1, now, now + MIN_RAMP_TIME });
+        t.legacy_ramp({ symbol_code{"XY"}, 1, 1, now, now + MIN_RAMP_TIME });
+
+        expect_match( t.push_error<sx::curve::migrate_action>( "myaccount"_n ), "missing authority" );
+        t.push<sx::curve::migrate_action>( "curve.sx"_n );
+        sx::curve::ramp_table _ramp( "curve.sx"_n, "curve.sx"_n.value );
+        expect( _ramp.begin() == _ramp.end(), "legacy ramps not erased" );
+
+        // active ramp keeps running, ended ramp is finalized, pairs ramped since the upgrade keep their own state
+        expect( t.pair( "BC" ).ramp_target_amplifier.value() == amp_bc * 2 && t.pair( "BC" ).invariant.has_value(), "BC ramp not migrated" );
+        expect( t.pair( "DE" ).amplifier == amp_de + 1 && t.pair( "DE" ).ramp_end_time.value() == time_point_sec{}, "DE ramp not finalized" );
+        expect( t.pair( "AB" ).ramp_end_time.value() == time_point_sec{}, "AB ramp overwritten" );
+
+        t.c.produce_block( eosio::hours( 1 ));
+        expect( sx::curve::get_amplifier( t.pair( "BC" )) > amp_bc, "BC amplifier did not ramp" );
+        t.push<sx::curve::stopramp_action>( "curve.sx"_n, symbol_code{"BC"} );
+    });
+}
+
+static void withdraw()
+{
+    run( "withdraw fake token", []() {
+        expect_match( t.transfer_error( "liquidity.sx"_n, "curve.sx"_n, "1000.0000 AB", "", "fake.token"_n ), "invalid extended symbol" );
+    });
+
+    run( "withdraw all", []() {
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, t.balance( "liquidity.sx"_n, "CAB", "lptoken.sx"_n ), "", "lptoken.sx"_n );
+        expect_eq( t.pair( "CAB" ).liquidity.quantity.to_string(), "0.000000000 CAB" );
+        expect_eq( t.pair( "CAB" ).reserve0.quantity.to_string(), "0.0000 AB" );
+        expect_eq( t.pair( "CAB" ).reserve1.quantity.to_string(), "0.000000000 C" );
+
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, t.balance( "liquidity.sx"_n, "AC", "lptoken.sx"_n ), "", "lptoken.sx"_n );
+        expect_eq( t.pair( "AC" ).liquidity.quantity.to_string(), "0.000000000 AC" );
+        expect_eq( t.pair( "AC" ).reserve0.quantity.to_string(), "0.0000 A" );
+        expect_eq( t.pair( "AC" ).reserve1.quantity.to_string(), "0.000000000 C" );
+
+        for ( const name owner : { "liquidity.sx"_n, "myaccount"_n, "fee.sx"_n } ) {
+            t.transfer( owner, "curve.sx"_n, t.balance( owner, "AB", "lptoken.sx"_n ), "", "lptoken.sx"_n );
+        }
+        expect_eq( t.pair( "AB" ).liquidity.quantity.to_string(), "0.0000 AB" );
+        expect_eq( t.pair( "AB" ).reserve0.quantity.to_string(), "0.0000 A" );
+        expect_eq( t.pair( "AB" ).reserve1.quantity.to_string(), "0.0000 B" );
+
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, t.balance( "liquidity.sx"_n, "BC", "lptoken.sx"_n ), "", "lptoken.sx"_n );
+        expect_eq( t.pair( "BC" ).liquidity.quantity.to_string(), "0.000000000 BC" );
+        expect_eq( t.pair( "BC" ).reserve0.quantity.to_string(), "0.0000 B" );
+        expect_eq( t.pair( "BC" ).reserve1.quantity.to_string(), "0.000000000 C" );
+
+        t.transfer( "liquidity.sx"_n, "curve.sx"_n, t.balance( "liquidity.sx"_n, "DE", "lptoken.sx"_n ), "", "lptoken.sx"_n );
+        expect_eq( t.pair( "DE" ).liquidity.quantity.to_string(), "0.000000 DE" );
+        expect_eq( t.pair( "DE" ).reserve0.quantity.to_string(), "0.000000 D" );
+        expect_eq( t.pair( "DE" ).reserve1.quantity.to_string(), "0.000000 E" );
+    });
+
+    run( "remove pairs", []() {
+        expect_match( t.push_error<sx::curve::removepair_action>( "curve.sx"_n, symbol_code{"BC"} ), "used by a route" );
+        t.push<sx::curve::delroute_action>( "curve.sx"_n, 1 );
+
+        for ( const string pair_id : { "AB", "AC", "BC", "CAB", "DE" } ) {
+            t.push<sx::curve::removepair_action>( "curve.sx"_n, symbol_code{ pair_id } );
+        }
+        expect_match( t.push_error<sx::curve::removepair_action>( "curve.sx"_n, symbol_code{"AD"} ), "does not exist" );
+    });
+}
+
+int main()
+{
+    config();
+    create_pairs();
+    liquidity();
+    swaps();
+    pools();
+    ramp();
+    withdraw();
+
+    printf( "1..%d\n", tests );
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#!/usr/bin/env bats
+
+load bats.global
+
+@test "create ABC pool" {
+  run cleos push action curve.sx createpool '["curve.sx", "ABC", [["4,A", "eosio.token"], ["4,B", "eosio.token"], ["9,C", "eosio.token"]], 450]' -p curve.sx
+  echo "Output: $output"
+  [ $status -eq 0 ]
+  result=$(cleos get table curve.sx curve.sx pools | jq -r '.rows[0].id')
+  [ $result = ABC ]
+}
+
+@test "invalid pools" {
+  run cleos push action curve.sx createpool '["curve.sx", "ABD", [["4,A", "eosio.token"], ["4,B", "eosio.token"]], 450]' -p curve.sx
+  echo "Output: $output"
+  [[ "$output" =~ "invalid number of reserves" ]]
+  [ $status -eq 1 ]
+
+  run cleos push action curve.sx createpool '["curve.sx", "AAC", [["4,A", "eosio.token"], ["4,A", "eosio.token"], ["9,C", "eosio.token"]], 450]' -p curve.sx
+  echo "Output: $output"
+  [[ "$output" =~ "invalid duplicate reserves" ]]
+  [ $status -eq 1 ]
+
+  run cleos push action curve.sx createpool '["curve.sx", "AB", [["4,A", "eosio.token"], ["4,B", "eosio.token"], ["9,C", "eosio.token"]], 450]' -p curve.sx
+  echo "Output: $output"
+  [[ "$output" =~ "already exists" ]]
+  [ $status -eq 1 ]
+}
+
+@test "deposit ABC" {
+  run cleos transfer liquidity.sx curve.sx "10000.0000 A" "deposit,ABC"
+  run cleos transfer liquidity.sx curve.sx "10000.0000 B" "deposit,ABC"
+  run cleos transfer liquidity.sx curve.sx "10000.000000000 C" "deposit,ABC"
+
+  result=$(cleos get table curve.sx ABC poolorders | jq -r '.rows[0].quantities[2].quantity')
+  [ "$result" = "10000.000000000 C" ]
+
+  run cleos push action curve.sx deposit '["liquidity.sx", "ABC", null]' -p liquidity.sx
+  [ $status -eq 0 ]
+
+  result=$(cleos get table curve.sx curve.sx pools | jq -r '.rows[0].liquidity.quantity')
+  [ "$result" = "30000.000000000 ABC" ]
+  result=$(cleos get table curve.sx curve.sx pools | jq -r '.rows[0].invariant')
+  [ "$result" = "30000000000" ]
+  result=$(cleos get currency balance lptoken.sx liquidity.sx ABC)
+  [ "$result" = "30000.000000000 ABC" ]
+}
+
+@test "swap ABC" {
+  run cleos transfer myaccount curve.sx "100.0000 A" "swappool,0,ABC,C"
+  echo "Output: $output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "99.957784000 C" ]]
+
+  run cleos transfer myaccount curve.sx "100.000000000 C" "swappool,0,ABC,B"
+  echo "Output: $output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "99.9600 B" ]]
+}
+
+@test "invalid pool swaps" {
+  run cleos transfer myaccount curve.sx "100.0000 A" "swappool,0,ABC,A"
+  echo "Output: $output"
+  [[ "$output" =~ "input and output reserves must be different" ]]
+  [ $status -eq 1 ]
+
+  run cleos transfer myaccount curve.sx "100.0000 A" "swappool,0,XYZ,C"
+  echo "Output: $output"
+  [[ "$output" =~ "does not exist" ]]
+  [ $status -eq 1 ]
+
+  run cleos transfer myaccount curve.sx "100.0000 A" "swappool,100000000000,ABC,C"
+  echo "Output: $output"
+  [[ "$output" =~ "invalid minimum return" ]]
+  [ $status -eq 1 ]
+
+  run cleos transfer myaccount curve.sx "100.0000 A" "swap,0,AB,C"
+  echo "Output: $output"
+  [[ "$output" =~ "invalid memo" ]]
+  [ $status -eq 1 ]
+}
+
+@test "withdraw ABC" {
+  run cleos transfer liquidity.sx curve.sx "3000.000000000 ABC" "" --contract lptoken.sx
+  echo "Output: $output"
+  [ $status -eq 0 ]
+  result=$(cleos get table curve.sx curve.sx pools | jq -r '.rows[0].liquidity.quantity')
+  [ "$result" = "27000.000000000 ABC" ]
+}
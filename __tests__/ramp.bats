@@ -60,19 +60,21 @@
 
 @test "stop ramp" {
 
-  amp=$(cleos get table curve.sx curve.sx ramp | jq -r '.rows[0].target_amplifier')
+  amp=$(cleos get table curve.sx curve.sx pairs | jq -r '.rows[0].ramp_target_amplifier')
   if [[ "$amp" != "200" ]]; then
       skip "no ramp set - production configuration?"
   fi
 
   run cleos push action curve.sx stopramp '["BC"]' -p curve.sx
   [ $status -eq 1 ]
-  [[ "$output" =~ "does not exist in" ]]
+  [[ "$output" =~ "no active ramp" ]]
 
   run cleos push action curve.sx stopramp '["AB"]' -p curve.sx
   [ $status -eq 0 ]
 
-  amp=$(cleos get table curve.sx curve.sx ramp | jq -r '.rows[0].target_amplifier')
-  [ -n "$amp" ]
+  amp=$(cleos get table curve.sx curve.sx pairs | jq -r '.rows[0].ramp_target_amplifier')
+  [ "$amp" = "0" ]
 
+  amp=$(cleos get table curve.sx curve.sx pairs | jq -r '.rows[1].ramp_target_amplifier')
+  [ "$amp" = "100" ]
 }
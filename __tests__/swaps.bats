@@ -78,11 +78,16 @@ load bats.global
   [[ "$output" =~ "invalid memo" ]]
   [ $status -eq 1 ]
 
-  run cleos transfer myaccount curve.sx "100.0000 B" "swap,900000,AB,foo"
+  run cleos transfer myaccount curve.sx "100.0000 B" "swap,900000,AB,FOO"
   echo "$output"
   [[ "$output" =~ "invalid memo" ]]
   [ $status -eq 1 ]
 
+  run cleos transfer myaccount curve.sx "100.0000 B" "swap,900000,AB,foo"
+  echo "$output"
+  [[ "$output" =~ "to account does not exist" ]]
+  [ $status -eq 1 ]
+
   run cleos transfer myaccount curve.sx "100.0000 A" "foo,0,AC"
   echo "$output"
   [[ "$output" =~ "invalid memo" ]]
@@ -137,31 +142,39 @@ load bats.global
   run cleos transfer myaccount curve.sx "1000.0000 A" "swap,0,AB"
   echo "$output"
   [ $status -eq 0 ]
-  [[ "$output" =~ "0.1000 A" ]]
   [[ "$output" =~ "998.0972 B" ]]
 
   run cleos transfer myaccount curve.sx "1000.0000 B" "swap,0,AB"
   echo "$output"
-  [[ "$output" =~ "0.1000 B" ]]
   [[ "$output" =~ "1000.9047 A" ]]
   [ $status -eq 0 ]
 
   run cleos transfer myaccount curve.sx "1000.0000 C" "swap,0,CAB"
   echo "$output"
-  [[ "$output" =~ "0.100000000 C" ]]
   [[ "$output" =~ "998.9296 AB" ]]
   [ $status -eq 0 ]
 
   run cleos transfer myaccount curve.sx "1000.000000 D" "swap,0,DE"
-  [[ "$output" =~ "0.100000 D" ]]
   [[ "$output" =~ "999.500001 E" ]]
   [ $status -eq 0 ]
 
   run cleos transfer myaccount curve.sx "1000.0000 AB" "swap,0,CAB" --contract lptoken.sx
-  [[ "$output" =~ "0.1000 AB" ]]
   [[ "$output" =~ "1000.070291000 C" ]]
   [ $status -eq 0 ]
 
+  fee_balance=$(cleos get currency balance eosio.token fee.sx A)
+  [ "$fee_balance" = "" ]
+
+  run cleos push action curve.sx claimfees '["eosio.token"]' -p myaccount
+  [ $status -eq 0 ]
+
+  run cleos push action curve.sx claimfees '["lptoken.sx"]' -p myaccount
+  [ $status -eq 0 ]
+
+  run cleos push action curve.sx claimfees '["eosio.token"]' -p myaccount
+  [[ "$output" =~ "no fees to claim" ]]
+  [ $status -eq 1 ]
+
   fee_balance=$(cleos get currency balance eosio.token fee.sx A)
   [ "$fee_balance" = "0.1000 A" ]
 
@@ -181,6 +194,71 @@ load bats.global
   [ $status -eq 0 ]
 }
 
+@test "swap exact output" {
+  run cleos transfer myaccount curve.sx "2000.0000 A" "swapout,10000000,AB"
+  echo "$output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "1000.0000 B" ]]
+  [[ "$output" =~ "curve.sx: refund" ]]
+
+  run cleos transfer myaccount curve.sx "500.0000 A" "swapout,100000000000,AB-BC"
+  echo "$output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "curve.sx: refund" ]]
+
+  run cleos transfer myaccount curve.sx "10.0000 A" "swapout,1000000000,AB"
+  echo "$output"
+  [[ "$output" =~ "insufficient input" ]]
+  [ $status -eq 1 ]
+
+  run cleos transfer myaccount curve.sx "10.0000 A" "swapout,0,AB"
+  echo "$output"
+  [[ "$output" =~ "invalid memo" ]]
+  [ $status -eq 1 ]
+}
+
+
+@test "swap to recipient" {
+  run cleos transfer myaccount curve.sx "10.0000 A" "swap,0,AB,liquidity.sx,order,123"
+  echo "$output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "\"to\":\"liquidity.sx\"" ]]
+  [[ "$output" =~ "order,123" ]]
+
+  run cleos transfer myaccount curve.sx "20.0000 A" "swapout,100000,AB,liquidity.sx"
+  echo "$output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "curve.sx: refund" ]]
+  [[ "$output" =~ "10.0000 B" ]]
+}
+
+@test "registered routes" {
+  run cleos push action curve.sx addroute '[1, ["4,A", "eosio.token"], ["BC"]]' -p curve.sx
+  echo "$output"
+  [[ "$output" =~ "invalid extended symbol" ]]
+  [ $status -eq 1 ]
+
+  run cleos push action curve.sx addroute '[1, ["4,A", "eosio.token"], ["AB", "BC"]]' -p curve.sx
+  [ $status -eq 0 ]
+
+  run cleos transfer myaccount curve.sx "10.0000 A" "swap,0,@1"
+  echo "$output"
+  [ $status -eq 0 ]
+  [[ "$output" =~ "{\"pair_id\":\"BC\"" ]]
+
+  run cleos transfer myaccount curve.sx "10.0000 B" "swap,0,@1"
+  echo "$output"
+  [[ "$output" =~ "invalid extended symbol" ]]
+  [ $status -eq 1 ]
+
+  run cleos transfer myaccount curve.sx "10.0000 A" "swap,0,@9"
+  echo "$output"
+  [[ "$output" =~ "does not exist" ]]
+  [ $status -eq 1 ]
+
+  run cleos push action curve.sx delroute '[1]' -p curve.sx
+  [ $status -eq 0 ]
+}
 
 @test "50 random swaps" {
   symbols="ABCDE"
@@ -210,3 +288,13 @@ load bats.global
   done
 }
 
+
+@test "solver stats" {
+  run cleos push action curve.sx solverstats '["AB", "100.0000 A"]' -p curve.sx
+  echo "Output: $output"
+  [ $status -eq 1 ]
+  [[ "$output" =~ "d_iterations=0" ]]
+  [[ "$output" =~ "y_iterations=1" ]]
+  [[ "$output" =~ "delta=0" ]]
+  [[ "$output" =~ "is_wide=0" ]]
+}
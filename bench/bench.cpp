@@ -0,0 +1,260 @@
+// native microbenchmarks for the math headers (`curve.hpp`, `sx.rex`, `sx.safemath`, `sx.utils`) & `curve::mul_amount` / `div_amount`
+//
+// cmake -S . -B build -DCMAKE_BUILD_TYPE=Release && cmake --build build
+// ./build/curve.bench [filter]
+
+#include <eosio/asset.hpp>
+
+using namespace eosio;
+
+#include <sx.safemath/safemath.hpp>
+#include <sx.rex/rex.hpp>
+#include <sx.utils/utils.hpp>
+#include <curve.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+
+using std::string;
+
+// keeps results alive so the optimizer cannot drop the measured calls
+static volatile uint64_t sink;
+
+static const char* filter = nullptr;
+
+static bool enabled( const string& name )
+{
+    return filter == nullptr || name.find( filter ) != string::npos;
+}
+
+// runs `fn(i)` until at least ~20ms have elapsed, returns average ns/op
+template <typename F>
+static double measure( F&& fn )
+{
+    using clock = std::chrono::steady_clock;
+    uint64_t iterations = 64;
+    while ( true ) {
+        const auto start = clock::now();
+        for ( uint64_t i = 0; i < iterations; ++i ) sink = sink + fn( i );
+        const double elapsed = std::chrono::duration<double, std::nano>( clock::now() - start ).count();
+        if ( elapsed >= 20e6 || iterations >= ( 1ULL << 30 ) ) return elapsed / iterations;
+        iterations *= 2;
+    }
+}
+
+template <typename F>
+static void bench( const string& name, F&& fn )
+{
+    if ( !enabled( name ) ) return;
+    printf( "%-56s %10.1f ns/op\n", name.c_str(), measure( fn ) );
+}
+
+// `Curve::get_amount_out` over amplifier x reserve imbalance x trade size
+static void bench_curve()
+{
+    const uint64_t amplifiers[] = { 1, 20, 100, 450, 2000, 100000, 1000000 };
+    const uint64_t imbalances[] = { 1, 2, 10, 100 };               // reserve_in : reserve_out
+    const uint64_t trade_bps[] = { 1, 100, 1000, 10000 };          // amount_in as bps of reserve_in
+    const uint64_t reserve = 1000000000000;                         // 1,000,000.000000 (MAX_PRECISION)
+    const uint8_t fee = 4;
+
+    if ( !enabled( "Curve::get_amount_out" ) ) return;
+
+    printf( "%-10s %-8s %-8s %10s %6s %6s %5s %14s\n", "amplifier", "ratio", "trade", "ns/op", "d_it", "y_it", "wide", "amount_out" );
+    for ( const uint64_t amplifier : amplifiers ) {
+        for ( const uint64_t imbalance : imbalances ) {
+            for ( const uint64_t bps : trade_bps ) {
+                const uint64_t reserve_in = reserve * imbalance;
+                const uint64_t reserve_out = reserve;
+                const uint64_t amount_in = reserve_in / 10000 * bps;
+
+                const Curve::solver_result result = Curve::get_solver_result( amount_in, reserve_in, reserve_out, amplifier, fee );
+                const double ns = measure( [&]( uint64_t i ) {
+                    return Curve::get_amount_out( amount_in + ( i & 7 ), reserve_in, reserve_out, amplifier, fee );
+                });
+                printf( "%-10llu %-8s %-8s %10.1f %6u %6u %5u %14llu\n",
+                    (unsigned long long) amplifier,
+                    ( std::to_string( imbalance ) + ":1" ).c_str(),
+                    ( std::to_string( bps / 100.0 ).substr( 0, 5 ) + "%" ).c_str(),
+                    ns, result.d_iterations, result.y_iterations, result.is_wide,
+                    (unsigned long long) result.amount_out );
+            }
+        }
+    }
+    printf( "\n" );
+
+    // known invariant (reused from the pair row) vs solving D from scratch
+    const uint64_t invariant = Curve::get_invariant( reserve, reserve, 450 );
+    bench( "Curve::get_amount_out (A=450, stored invariant)", [&]( uint64_t i ) {
+        return Curve::get_amount_out( 1000000 + ( i & 7 ), reserve, reserve, 450, fee, invariant );
+    });
+    bench( "Curve::get_amount_in (A=450)", [&]( uint64_t i ) {
+        return Curve::get_amount_in( 1000000 + ( i & 7 ), reserve, reserve, 450, fee );
+    });
+    bench( "Curve::get_invariant (A=450)", [&]( uint64_t i ) {
+        return Curve::get_invariant( reserve + ( i & 7 ), reserve, 450 );
+    });
+    bench( "Curve::get_amount_out (18 decimals, wide)", [&]( uint64_t i ) {
+        return Curve::get_amount_out( 1000000000000000000 + ( i & 7 ), 1000000000000000000, 4611686018427387000, 450, fee );
+    });
+}
+
+static void bench_rex()
+{
+    bench( "rex::issue", []( uint64_t i ) {
+        return rex::issue( 10000 + ( i & 7 ), 1000000, 10000000000 );
+    });
+    bench( "rex::retire", []( uint64_t i ) {
+        return rex::retire( 100000000 + ( i & 7 ), 1000000, 10000000000 );
+    });
+}
+
+// precision rescaling of `curve::mul_amount` / `div_amount` between `MAX_PRECISION` (6) & token precisions
+// before: floating point `pow` factor & `safemath::mul` round trip
+static int64_t mul_amount_pow( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+{
+    const int64_t res = static_cast<int64_t>( precision0 >= precision1 ? safemath::mul(amount, pow(10, precision0 - precision1 )) : amount / static_cast<int64_t>(pow( 10, precision1 - precision0 )));
+    eosio::check(res >= 0, "curve::mul_amount: mul/div overflow");
+    return res;
+}
+
+static int64_t div_amount_pow( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+{
+    return precision0 >= precision1 ? amount / static_cast<int64_t>(pow( 10, precision0 - precision1 )) : safemath::mul(amount, pow( 10, precision1 - precision0 ));
+}
+
+// after: `safemath::pow10` table, equal precisions return early
+static int64_t mul_amount_table( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+{
+    eosio::check(amount >= 0, "curve::mul_amount: mul/div overflow");
+    if ( precision0 == precision1 ) return amount;
+    if ( precision0 < precision1 ) return amount / safemath::pow10( precision1 - precision0 );
+
+    const int64_t factor = safemath::pow10( precision0 - precision1 );
+    eosio::check(amount <= INT64_MAX / factor, "curve::mul_amount: mul/div overflow");
+    return amount * factor;
+}
+
+static int64_t div_amount_table( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
+{
+    if ( precision0 == precision1 ) return amount;
+    if ( precision0 > precision1 ) return amount / safemath::pow10( precision0 - precision1 );
+
+    const int64_t factor = safemath::pow10( precision1 - precision0 );
+    eosio::check(amount <= INT64_MAX / factor && amount >= INT64_MIN / factor, "curve::div_amount: mul overflow");
+    return amount * factor;
+}
+
+static void bench_amounts()
+{
+    // precision is read at runtime (token symbols), the optimizer cannot fold the factor
+    static volatile uint8_t precisions[] = { 4, 6, 8 };
+    for ( size_t index = 0; index < 3; ++index ) {
+        const string suffix = " (6, " + std::to_string( precisions[index] ) + ")";
+        bench( "curve::mul_amount pow" + suffix, [&]( uint64_t i ) {
+            return mul_amount_pow( 100000000 + ( i & 7 ), 6, precisions[index] );
+        });
+        bench( "curve::mul_amount table" + suffix, [&]( uint64_t i ) {
+            return mul_amount_table( 100000000 + ( i & 7 ), 6, precisions[index] );
+        });
+        bench( "curve::div_amount pow" + suffix, [&]( uint64_t i ) {
+            return div_amount_pow( 100000000 + ( i & 7 ), 6, precisions[index] );
+        });
+        bench( "curve::div_amount table" + suffix, [&]( uint64_t i ) {
+            return div_amount_table( 100000000 + ( i & 7 ), 6, precisions[index] );
+        });
+    }
+}
+
+static void bench_utils()
+{
+    bench( "sx::utils::split", []( uint64_t i ) {
+        return sx::utils::split( "swap,0,AB,BC", "," ).size() + ( i & 1 );
+    });
+    bench( "sx::utils::parse_name", []( uint64_t i ) {
+        return sx::utils::parse_name( "curve.sx" ).value + ( i & 1 );
+    });
+    bench( "sx::utils::parse_symbol_code", []( uint64_t i ) {
+        return sx::utils::parse_symbol_code( "USDT" ).raw() + ( i & 1 );
+    });
+    bench( "sx::utils::parse_symbol", []( uint64_t i ) {
+        return sx::utils::parse_symbol( "4,USDT" ).raw() + ( i & 1 );
+    });
+    bench( "sx::utils::parse_asset", []( uint64_t i ) {
+        return static_cast<uint64_t>( sx::utils::parse_asset( "1.0000 USDT" ).amount ) + ( i & 1 );
+    });
+    bench( "sx::utils::parse_extended_symbol", []( uint64_t i ) {
+        return sx::utils::parse_extended_symbol( "4,USDT@tethertether" ).get_contract().value + ( i & 1 );
+    });
+    bench( "sx::utils::parse_extended_asset", []( uint64_t i ) {
+        return static_cast<uint64_t>( sx::utils::parse_extended_asset( "1.0000 USDT@tethertether" ).quantity.amount ) + ( i & 1 );
+    });
+}
+
+// syntax path of `curve::parse_memo` for "swap,<min_return>,<pair_ids>" (table lookups excluded)
+// before: `split` copies every token, `std::stoll` & a `std::set` for duplicate `pair_ids`
+static uint64_t parse_memo_split( const string& memo )
+{
+    const std::vector<string> parts = sx::utils::split( memo, "," );
+    if ( parts.size() != 3 || !sx::utils::is_digit( parts[1] ) ) return 0;
+    uint64_t result = sx::utils::parse_name( parts[0] ).value + std::stoll( parts[1] );
+
+    std::set<symbol_code> duplicates;
+    for ( const auto& str : sx::utils::split( parts[2], "-" ) ) {
+        const symbol_code symcode = sx::utils::parse_symbol_code( str );
+        if ( !symcode.raw() || !duplicates.insert( symcode ).second ) return 0;
+        result += symcode.raw();
+    }
+    return result;
+}
+
+// after: `string_view` tokens, `parse_digits` & inline `fixed_vector` with a linear duplicate scan
+static uint64_t parse_memo_views( const std::string_view memo )
+{
+    std::string_view rest = memo;
+    const std::string_view action = sx::utils::next_token( rest, ',' );
+    const int64_t min_return = sx::utils::parse_digits( sx::utils::next_token( rest, ',' ) );
+    std::string_view pair_ids = sx::utils::next_token( rest, ',' );
+    if ( min_return < 0 || pair_ids.empty() || !sx::utils::next_token( rest, ',' ).empty() ) return 0;
+    uint64_t result = sx::utils::parse_name( action ).value + min_return;
+
+    sx::utils::fixed_vector<symbol_code, 125> symcodes;
+    for ( std::string_view str = sx::utils::next_token( pair_ids, '-' ); !str.empty(); str = sx::utils::next_token( pair_ids, '-' ) ) {
+        const symbol_code symcode = sx::utils::parse_symbol_code( str );
+        if ( !symcode.raw() || std::find( symcodes.begin(), symcodes.end(), symcode ) != symcodes.end() ) return 0;
+        symcodes.push_back( symcode );
+        result += symcode.raw();
+    }
+    return result;
+}
+
+static void bench_memo()
+{
+    const string memos[] = { "swap,0,AB", "swap,1000000,AB-BC-CD", "swap,0,USDT-SXA-SXB" };
+    for ( const string& memo : memos ) {
+        if ( parse_memo_split( memo ) != parse_memo_views( memo ) ) printf( "parse_memo mismatch: %s\n", memo.c_str() );
+        bench( "curve::parse_memo split " + memo, [&]( uint64_t i ) {
+            return parse_memo_split( memo ) + ( i & 1 );
+        });
+        bench( "curve::parse_memo string_view " + memo, [&]( uint64_t i ) {
+            return parse_memo_views( memo ) + ( i & 1 );
+        });
+    }
+}
+
+int main( int argc, char** argv )
+{
+    if ( argc > 1 ) filter = argv[1];
+
+    bench_curve();
+    bench_rex();
+    bench_amounts();
+    bench_utils();
+    bench_memo();
+    return 0;
+}
@@ -1,11 +1,555 @@
 #pragma once
 
+#include <math.h>
+#include <array>
+#include <vector>
 #include <sx.safemath/safemath.hpp>
 
 using namespace eosio;
 
+// solver iteration counters of `CURVE_PROFILE` builds (src/profile.hpp)
+#ifndef CURVE_PROFILE_COUNT
+#define CURVE_PROFILE_COUNT( counter, n )
+#endif
+
 namespace Curve {
     const int MAX_ITERATIONS = 10;
+
+    /**
+     * ## STRUCT `solver_result`
+     *
+     * Optional solver telemetry, filled when a pointer is passed to `get_invariant<N>` / `get_amount_out<N>`
+     *
+     * - `{uint64_t} amount_out` - amount output
+     * - `{uint64_t} invariant` - invariant D
+     * - `{uint8_t} d_iterations` - Newton iterations used to solve D (0 when a known invariant is reused)
+     * - `{uint8_t} y_iterations` - integer square root steps used to solve the new reserve out
+     * - `{uint64_t} delta` - `|D - D_prev|` of the last D iteration, non-zero when `MAX_ITERATIONS` ran out before converging
+     * - `{bool} is_wide` - 256-bit intermediates were required
+     */
+    struct solver_result {
+        uint64_t    amount_out = 0;
+        uint64_t    invariant = 0;
+        uint8_t     d_iterations = 0;
+        uint8_t     y_iterations = 0;
+        uint64_t    delta = 0;
+        bool        is_wide = false;
+    };
+    /**
+     * ## STATIC `get_invariant_fast`
+     *
+     * Fast path of `get_invariant`: seeds D with double precision Newton iterations and confirms it with one exact integer step.
+     * A seed is only accepted when it is provably the fixed point the reference integer loop converges to:
+     *
+     * - the reference loop cannot overflow and converges well within `MAX_ITERATIONS`
+     * - the rounding of `prod1` is too small to create a neighbouring fixed point
+     *
+     * ### params
+     *
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### returns
+     *
+     * - `{uint64_t}` - invariant D (0 if the reference loop must be used)
+     */
+    static uint64_t get_invariant_fast( const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, solver_result* result = nullptr )
+    {
+        const uint64_t sum = reserve_in + reserve_out;
+        const double S = sum, A = amplifier, R_in = 2.0 * reserve_in, R_out = 2.0 * reserve_out;
+
+        // prod1 is the largest at D = sum, which is where the reference loop starts
+        if ( A * S + S * S / R_in * S / R_out >= 0x1p63 ) return 0;
+
+        // replay the reference loop in double precision
+        double D = S;
+        int i = 0;
+        while ( i++ < MAX_ITERATIONS ) {
+            const double prod1 = D * D / R_in * D / R_out;
+            const double D_next = 2 * D * (A * S + prod1) / ((2 * A - 1) * D + 3 * prod1);
+            const bool converged = fabs( D_next - D ) < 1;
+            D = D_next;
+            if ( converged ) break;
+        }
+        if ( i > MAX_ITERATIONS - 4 ) return 0;
+
+        // confirm seed with exact integer steps
+        uint128_t x = D;
+        for ( int j = 0; j < 2; j++ ) {
+            const uint128_t prod1 = x * x / (reserve_in * 2) * x / (reserve_out * 2);
+            const uint128_t numerator = 2 * x * (safemath::mul(amplifier, sum) + prod1);
+            const uint128_t denominator = (2 * amplifier - 1) * x + 3 * prod1;
+            const uint128_t x_next = numerator / denominator;
+            if ( x_next != x ) { x = x_next; continue; }
+
+            // flooring prod1 moves the next D by at most `noise`, fractional part must stay clear of it
+            const double X = x, Q = denominator;
+            const double noise = 2 * X * fabs( (2 * A - 1) * X - 3 * A * S ) / (Q * Q) * (X / R_out + 1);
+            const double frac = static_cast<double>( numerator - x_next * denominator ) / Q;
+            const double margin = 2 * noise + 4 / X;
+            if ( noise < 0.25 && frac >= margin && frac < 1 - margin ) {
+                if ( result ) { result->d_iterations = i; result->delta = 0; }
+                CURVE_PROFILE_COUNT( d_iterations, i );
+                return x;
+            }
+            break;
+        }
+        return 0;
+    }
+
+    /**
+     * ## STATIC `isqrt`
+     *
+     * Integer square root, largest `r` such that `r * r <= n`
+     *
+     * ### params
+     *
+     * - `{uint128_t} n` - radicand
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint128_t r = curve::isqrt( 99 );
+     * // => 9
+     * ```
+     */
+    static uint128_t isqrt( const uint128_t n )
+    {
+        if ( n == 0 ) return 0;
+
+        // double precision seed is within 2^11 of the root, one integer Newton step brings it to r or r + 1
+        const uint128_t max = ~uint64_t(0);
+        uint128_t r = sqrt( static_cast<double>( n ) );
+        if ( r > max ) r = max;
+        r = (r + n / r) / 2;
+        if ( r > max ) r = max;
+        if ( r * r > n ) r--;
+        return r;
+    }
+
+    /**
+     * ## STATIC `isqrt`
+     *
+     * Integer square root of a 256-bit radicand, largest `r` such that `r * r <= n`
+     *
+     * ### params
+     *
+     * - `{uint256_t} n` - radicand
+     * - `{uint8_t*} [iterations=nullptr]` - optional count of Newton steps
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint128_t r = curve::isqrt( safemath::mul256( uint128_t(1) << 100, uint128_t(1) << 100 ) );
+     * // => 1 << 100
+     * ```
+     */
+    static uint128_t isqrt( const safemath::uint256_t& n, uint8_t* iterations = nullptr )
+    {
+        if ( iterations ) *iterations = 1;
+        if ( n.hi == 0 ) return isqrt( n.lo );
+
+        // floor((x + n / x) / 2) is never below the root, Newton steps from the double seed descend onto it
+        const auto step = [&]( const uint128_t x ) {
+            const safemath::uint256_t t = safemath::add256( safemath::div256( n, x ), { 0, x } );
+            return t.hi >> 1 ? ~uint128_t(0) : (t.hi << 127) | (t.lo >> 1);
+        };
+        const double seed = sqrt( static_cast<double>( n.hi ) * 0x1p128 + static_cast<double>( n.lo ) );
+        uint128_t r = step( seed >= 0x1p128 ? ~uint128_t(0) : static_cast<uint128_t>( seed ) );
+        while ( true ) {
+            const uint128_t next = step( r );
+            if ( iterations ) ++*iterations;
+            if ( next >= r ) return r;
+            r = next;
+        }
+    }
+
+    /**
+     * ## STATIC `get_y`
+     *
+     * Solves `x^2 + b*x = c` in closed form, returns the largest integer x such that `x * (x + b) <= c`
+     * (the fixed point of the integer Newton iteration `x = (x^2 + c) / (2x + b)`)
+     *
+     * With `b = 2h + e`:
+     *
+     * - e == 0: `(x + h)^2 <= c + h^2`, x = isqrt(c + h^2) - h
+     * - e == 1: `(x + h) * (x + h + 1) <= c + h^2 + h`
+     *
+     * ### params
+     *
+     * - `{int128_t} b` - linear coefficient
+     * - `{uint128_t} c` - constant
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint128_t x = curve::get_y( 3, 10 );
+     * // => 2
+     * ```
+     */
+    static uint128_t get_y( const int128_t b, const uint128_t c )
+    {
+        const int128_t h = b >= 0 ? b / 2 : -((1 - b) / 2);
+        const bool e = b - 2 * h;
+        const uint128_t h2 = static_cast<uint128_t>( h * h ) + (e ? h : 0);
+        const uint128_t M = c + h2;
+        check(M >= c, "curve.sx::get_amount_out: y overflow");
+
+        uint128_t k = isqrt( M );
+        if ( e && k * (k + 1) > M ) k--;
+        return k - h;
+    }
+
+    /**
+     * ## STATIC `get_y`
+     *
+     * Same as `get_y` with a 256-bit constant, used by the wide solver path
+     *
+     * ### params
+     *
+     * - `{int128_t} b` - linear coefficient
+     * - `{uint256_t} c` - constant
+     * - `{uint8_t*} [iterations=nullptr]` - optional count of square root steps
+     */
+    static uint128_t get_y( const int128_t b, const safemath::uint256_t& c, uint8_t* iterations = nullptr )
+    {
+        const int128_t h = b >= 0 ? b / 2 : -((1 - b) / 2);
+        const bool e = b - 2 * h;
+
+        // h^2 + e*h == |h| * (|h| + e) for h >= 0 and |h| * (|h| - e) for h < 0
+        const uint128_t g = h >= 0 ? h : -h;
+        const safemath::uint256_t h2 = safemath::mul256( g, h >= 0 ? g + e : g - e );
+        const safemath::uint256_t M = { c.hi + h2.hi + (c.lo + h2.lo < c.lo), c.lo + h2.lo };
+        check(!(M < c), "curve.sx::get_amount_out: y overflow");
+
+        uint128_t k = isqrt( M, iterations );
+        if ( e && safemath::mul256( k, k + 1 ) > M ) k--;
+        check(h >= 0 ? k >= g : k + g >= k, "curve.sx::get_amount_out: y overflow");
+        return h >= 0 ? k - g : k + g;
+    }
+
+    /**
+     * ## STATIC `get_invariant_wide<N>`
+     *
+     * `get_invariant<N>` with 128-bit reserves and 256-bit intermediates
+     * Runs the same integer iteration, results are identical wherever the 128-bit path does not overflow
+     * Accepts reserves up to 2^120, enough for full int64 assets normalized to 18 decimals
+     *
+     * ### params
+     *
+     * - `{array<uint128_t, N>} reserves` - reserves
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### example
+     *
+     * ```c++
+     * // 1e12 tokens per reserve normalized to 18 decimals
+     * const uint128_t reserve = uint128_t(1000000000000) * 1000000000000000000;
+     * const uint128_t invariant = curve::get_invariant_wide<2>( { reserve, reserve }, 450 );
+     * // => 2 * reserve
+     * ```
+     */
+    template <uint8_t N>
+    static uint128_t get_invariant_wide( const std::array<uint128_t, N>& reserves, const uint64_t amplifier, solver_result* result = nullptr )
+    {
+        static_assert( N >= 2, "curve.sx::get_invariant: requires at least 2 reserves" );
+        eosio::check(amplifier > 0, "curve.sx::get_invariant: invalid amplifier");
+        for ( const uint128_t reserve : reserves ) eosio::check(reserve > 0, "curve.sx::get_invariant: insufficient liquidity");
+        for ( const uint128_t reserve : reserves ) eosio::check(reserve < (uint128_t(1) << 120), "curve.sx::get_invariant: invalid reserves");
+
+        uint128_t sum = 0;
+        for ( const uint128_t reserve : reserves ) sum += reserve;
+        const safemath::uint256_t amplified_sum = safemath::mul256( amplifier, sum );
+        check(amplified_sum.hi == 0, "curve.sx::get_invariant: d1 overflow");
+
+        uint128_t D = sum, D_prev = 0;
+        uint8_t iterations = 0;
+        while ( D != D_prev && iterations < MAX_ITERATIONS ) {
+            iterations++;
+            uint128_t prod1 = D;
+            for ( const uint128_t reserve : reserves ) prod1 = safemath::muldiv( prod1, D, reserve * N );
+            const uint128_t d1 = amplified_sum.lo + prod1;
+            check(d1 >= prod1, "curve.sx::get_invariant: d1 overflow");
+            const safemath::uint256_t denominator = safemath::add256( safemath::mul256( uint128_t(amplifier) * N - 1, D ), safemath::mul256( N + 1, prod1 ) );
+            check(denominator.hi == 0, "curve.sx::get_invariant: d1 overflow");
+            D_prev = D;
+            D = safemath::muldiv( N * D, d1, denominator.lo );
+        }
+        CURVE_PROFILE_COUNT( d_iterations, iterations );
+        if ( result ) {
+            result->d_iterations = iterations;
+            result->delta = D > D_prev ? D - D_prev : D_prev - D;
+            result->is_wide = true;
+        }
+        return D;
+    }
+
+    /**
+     * ## STATIC `get_invariant<N>`
+     *
+     * Given N reserves and amplifier, returns the invariant D based on Curve formula
+     * Constants depending on the number of coins are folded at compile time, N == 2 uses the seeded fast path
+     *
+     * ### params
+     *
+     * - `{array<uint64_t, N>} reserves` - reserves
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint64_t invariant = curve::get_invariant<3>( { 3432247548, 6169362700, 5000000000 }, 450 );
+     * ```
+     */
+    template <uint8_t N>
+    static uint64_t get_invariant( const std::array<uint64_t, N>& reserves, const uint64_t amplifier, solver_result* result = nullptr )
+    {
+        static_assert( N >= 2, "curve.sx::get_invariant: requires at least 2 reserves" );
+        eosio::check(amplifier > 0, "curve.sx::get_invariant: invalid amplifier");
+        for ( const uint64_t reserve : reserves ) eosio::check(reserve > 0, "curve.sx::get_invariant: insufficient liquidity");
+        for ( const uint64_t reserve : reserves ) eosio::check(reserve < (1LL << 62) - 1, "curve.sx::get_invariant: invalid reserves");
+
+        // N * D * (A * sum + prod1) must fit in 128 bits, otherwise the loop is replayed with 256-bit intermediates
+        uint64_t sum = 0;
+        for ( const uint64_t reserve : reserves ) sum += reserve;
+        bool is_wide = sum > (1ULL << 63) / N * 2;
+
+        if constexpr ( N == 2 ) {
+            const uint64_t invariant = is_wide ? 0 : get_invariant_fast( reserves[0], reserves[1], amplifier, result );
+            if ( invariant ) {
+                if ( result ) result->invariant = invariant;
+                return invariant;
+            }
+        }
+
+        // calculate invariant D by solving equation:
+        // A * sum * n^n + D = A * D * n^n + D^(n+1) / (n^n * prod)
+        uint128_t D = sum, D_prev = 0;
+        uint8_t iterations = 0;
+        while ( !is_wide && D != D_prev && iterations < MAX_ITERATIONS ) {
+            iterations++;
+            uint128_t prod1 = D;
+            for ( const uint64_t reserve : reserves ) {
+                is_wide |= (prod1 >> 64) != 0;
+                prod1 = prod1 * D / (reserve * N);
+            }
+            const uint128_t d1 = safemath::mul( amplifier, sum ) + prod1;
+            is_wide |= (d1 >> 64) != 0;
+            if ( is_wide ) break;
+            D_prev = D;
+            D = N * D * d1 / ((N * amplifier - 1) * D + (N + 1) * prod1);
+        }
+        CURVE_PROFILE_COUNT( d_iterations, iterations );
+        if ( is_wide ) {
+            std::array<uint128_t, N> wide;
+            for ( uint8_t k = 0; k < N; k++ ) wide[k] = reserves[k];
+            D = get_invariant_wide<N>( wide, amplifier, result );
+        } else if ( result ) {
+            result->d_iterations = iterations;
+            result->delta = D > D_prev ? D - D_prev : D_prev - D;
+        }
+        check((uint64_t)D == D, "curve.sx::get_invariant: d2 overflow");
+        if ( result ) result->invariant = D;
+
+        return D;
+    }
+
+    /**
+     * ## STATIC `get_invariant`
+     *
+     * Given reserves pair and amplifier, returns the invariant D based on Curve formula
+     * Whitepaper: https://www.curve.fi/stableswap-paper.pdf
+     *
+     * ### params
+     *
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### example
+     *
+     * ```c++
+     * // Inputs
+     * const uint64_t reserve_in = 3432247548;
+     * const uint64_t reserve_out = 6169362700;
+     * cont uint64_t amplifier = 450;
+     *
+     * // Calculation
+     * const uint64_t invariant = curve::get_invariant( reserve_in, reserve_out, amplifier );
+     * // => 9600668971
+     * ```
+     */
+    static uint64_t get_invariant( const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, solver_result* result = nullptr )
+    {
+        return get_invariant<2>( { reserve_in, reserve_out }, amplifier, result );
+    }
+
+    /**
+     * ## STATIC `get_amount_out_wide<N>`
+     *
+     * `get_amount_out<N>` with 128-bit amounts and 256-bit intermediates (ex: reserves normalized to 18 decimals)
+     * `invariant` must be calculated by `get_invariant_wide<N>` using the same reserves & amplifier
+     *
+     * ### params
+     *
+     * - `{uint128_t} amount_in` - amount input
+     * - `{array<uint128_t, N>} reserves` - reserves
+     * - `{uint8_t} index_in` - index of input reserve
+     * - `{uint8_t} index_out` - index of output reserve
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     * - `{uint128_t} invariant` - invariant D
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint128_t invariant = curve::get_invariant_wide<2>( reserves, amplifier );
+     * const uint128_t amount_out = curve::get_amount_out_wide<2>( amount_in, reserves, 0, 1, amplifier, fee, invariant );
+     * ```
+     */
+    template <uint8_t N>
+    static uint128_t get_amount_out_wide( const uint128_t amount_in, const std::array<uint128_t, N>& reserves, const uint8_t index_in, const uint8_t index_out, const uint64_t amplifier, const uint8_t fee, const uint128_t invariant, solver_result* result = nullptr )
+    {
+        eosio::check(amount_in > 0, "curve.sx::get_amount_out: insufficient input amount");
+        eosio::check(amount_in < (uint128_t(1) << 120), "curve.sx::get_amount_out: invalid input amount");
+        eosio::check(amplifier > 0, "curve.sx::get_amount_out: invalid amplifier");
+        eosio::check(index_in < N && index_out < N && index_in != index_out, "curve.sx::get_amount_out: invalid reserve index");
+        for ( const uint128_t reserve : reserves ) eosio::check(reserve > 0, "curve.sx::get_amount_out: insufficient liquidity");
+        for ( const uint128_t reserve : reserves ) eosio::check(reserve < (uint128_t(1) << 120), "curve.sx::get_amount_out: invalid reserves");
+        eosio::check(invariant > 0 && invariant < (uint128_t(1) << 123), "curve.sx::get_amount_out: invalid invariant");
+
+        // same equation as `get_amount_out<N>`, only the last step of c needs more than 128 bits
+        const uint128_t D = invariant;
+        uint128_t sum = 0, c = D;
+        for ( uint8_t k = 0; k < N; k++ ) {
+            if ( k == index_out ) continue;
+            const uint128_t reserve = k == index_in ? reserves[k] + amount_in : reserves[k];
+            sum += reserve;
+            c = safemath::muldiv( c, D, reserve * N );
+        }
+        const safemath::uint256_t c_wide = safemath::div256( safemath::mul256( c, D ), uint128_t(amplifier) * N * N );
+        const int128_t b = (int128_t) (sum + (D / (uint128_t(amplifier) * N))) - (int128_t) D;
+        uint8_t y_iterations = 0;
+        const uint128_t x = get_y( b, c_wide, &y_iterations );
+        if ( result ) result->y_iterations = y_iterations;
+        CURVE_PROFILE_COUNT( y_iterations, y_iterations );
+        check(reserves[index_out] > x, "curve.sx::get_amount_out: insufficient reserve out");
+        const uint128_t amount_out = reserves[index_out] - x;
+        const uint128_t amount_out_net = amount_out - fee * amount_out / 10000;
+        if ( result ) {
+            result->amount_out = amount_out_net;
+            result->is_wide = true;
+        }
+        return amount_out_net;
+    }
+
+    /**
+     * ## STATIC `get_amount_out<N>`
+     *
+     * Given an input amount, N reserves, amplifier and a known invariant D, returns the output amount of reserve `index_out`
+     * `invariant` must be calculated by `get_invariant<N>` using the same reserves & amplifier
+     *
+     * ### params
+     *
+     * - `{uint64_t} amount_in` - amount input
+     * - `{array<uint64_t, N>} reserves` - reserves
+     * - `{uint8_t} index_in` - index of input reserve
+     * - `{uint8_t} index_out` - index of output reserve
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     * - `{uint64_t} invariant` - invariant D
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint64_t invariant = curve::get_invariant<3>( reserves, amplifier );
+     * const uint64_t amount_out = curve::get_amount_out<3>( amount_in, reserves, 0, 2, amplifier, fee, invariant );
+     * ```
+     */
+    template <uint8_t N>
+    static uint64_t get_amount_out( const uint64_t amount_in, const std::array<uint64_t, N>& reserves, const uint8_t index_in, const uint8_t index_out, const uint64_t amplifier, const uint8_t fee, const uint64_t invariant, solver_result* result = nullptr )
+    {
+        eosio::check(amount_in > 0, "curve.sx::get_amount_out: insufficient input amount");
+        eosio::check(amplifier > 0, "curve.sx::get_amount_out: invalid amplifier");
+        eosio::check(index_in < N && index_out < N && index_in != index_out, "curve.sx::get_amount_out: invalid reserve index");
+        for ( const uint64_t reserve : reserves ) eosio::check(reserve > 0, "curve.sx::get_amount_out: insufficient liquidity");
+        for ( const uint64_t reserve : reserves ) eosio::check(reserve < (1LL << 62) - 1, "curve.sx::get_amount_out: invalid reserves");
+        eosio::check(invariant > 0, "curve.sx::get_amount_out: invalid invariant");
+
+        // calculate x - new value for reserve_out by solving quadratic equation:
+        // x^2 + x * (sum' - (An^n - 1) * D / (An^n)) = D ^ (n + 1) / (n^(2n) * prod' * A)
+        // x^2 + b*x = c
+        // sum' & prod' exclude reserve_out and include amount_in
+        const uint128_t D = invariant;
+        uint128_t sum = 0, c = D;
+        bool is_wide = false;
+        for ( uint8_t k = 0; k < N; k++ ) {
+            if ( k == index_out ) continue;
+            const uint128_t reserve = k == index_in ? static_cast<uint128_t>( reserves[k] ) + amount_in : reserves[k];
+            sum += reserve;
+            is_wide |= (c >> 64) != 0;
+            c = c * D / (reserve * N);
+        }
+
+        // 128-bit intermediates are exact while c stays below 2^64 and sum below 2^63 (bounds c + b^2 / 4 in `get_y`)
+        is_wide |= (c >> 64) != 0 || (sum >> 63) != 0;
+        if ( is_wide ) {
+            std::array<uint128_t, N> wide;
+            for ( uint8_t k = 0; k < N; k++ ) wide[k] = reserves[k];
+            return get_amount_out_wide<N>( amount_in, wide, index_in, index_out, amplifier, fee, invariant, result );
+        }
+        c = c * D / (amplifier * N * N);
+        const int128_t b = (int128_t) (sum + (D / (amplifier * N))) - (int128_t) D;
+        const uint128_t x = get_y( b, c );
+        CURVE_PROFILE_COUNT( y_iterations, 1 );
+        check(reserves[index_out] > x, "curve.sx::get_amount_out: insufficient reserve out");
+        const uint64_t amount_out = reserves[index_out] - (uint64_t)x;
+        const uint64_t amount_out_net = amount_out - fee * static_cast<uint128_t>( amount_out ) / 10000;
+        if ( result ) {
+            result->amount_out = amount_out_net;
+            result->y_iterations = 1;
+        }
+
+        return amount_out_net;
+    }
+
+    /**
+     * ## STATIC `get_amount_out`
+     *
+     * Given an input amount, reserves pair, amplifier and a known invariant D, returns the output amount of the other asset
+     * Skips solving the invariant, `invariant` must be calculated by `get_invariant` using the same reserves & amplifier
+     *
+     * ### params
+     *
+     * - `{uint64_t} amount_in` - amount input
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     * - `{uint64_t} invariant` - invariant D
+     * - `{solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint64_t invariant = curve::get_invariant( reserve_in, reserve_out, amplifier );
+     * const uint64_t amount_out = curve::get_amount_out( amount_in, reserve_in, reserve_out, amplifier, fee, invariant );
+     * // => 100110
+     * ```
+     */
+    static uint64_t get_amount_out( const uint64_t amount_in, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee, const uint64_t invariant, solver_result* result = nullptr )
+    {
+        if ( result ) result->invariant = invariant;
+        return get_amount_out<2>( amount_in, { reserve_in, reserve_out }, 0, 1, amplifier, fee, invariant, result );
+    }
+
     /**
      * ## STATIC `get_amount_out`
      *
@@ -39,37 +583,180 @@ namespace Curve {
     static uint64_t get_amount_out( const uint64_t amount_in, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee )
     {
         eosio::check(amount_in > 0, "curve.sx::get_amount_out: insufficient input amount");
-        eosio::check(amplifier > 0, "curve.sx::get_amount_out: invalid amplifier");
-        eosio::check(reserve_in > 0 && reserve_out > 0, "curve.sx::get_amount_out: insufficient liquidity");
-        eosio::check(reserve_in < (1LL << 62) - 1 && reserve_out < (1LL << 62) - 1, "curve.sx::get_amount_out: invalid reserves");
 
-        // calculate invariant D by solving quadratic equation:
-        // A * sum * n^n + D = A * D * n^n + D^(n+1) / (n^n * prod), where n==2
-        const uint64_t sum = reserve_in + reserve_out;
-        uint128_t D = sum, D_prev = 0;
-        int i = MAX_ITERATIONS;
-        while ( D != D_prev && i--) {
-            uint128_t prod1 = D * D / (reserve_in * 2) * D / (reserve_out * 2);
-            D_prev = D;
-            check((uint64_t)(safemath::mul( amplifier, sum ) + prod1) == safemath::mul( amplifier, sum ) + prod1, "curve.sx::get_amount_out: d1 overflow");
-            D = 2 * D * (safemath::mul(amplifier, sum) + prod1) / ((2 * amplifier - 1) * D + 3 * prod1);
+        return get_amount_out( amount_in, reserve_in, reserve_out, amplifier, fee, get_invariant( reserve_in, reserve_out, amplifier ) );
+    }
+
+    /**
+     * ## STATIC `get_solver_result`
+     *
+     * Same as `get_amount_out` solving D from scratch, returns the output together with solver telemetry
+     *
+     * ### params
+     *
+     * - `{uint64_t} amount_in` - amount input
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     *
+     * ### example
+     *
+     * ```c++
+     * const curve::solver_result result = curve::get_solver_result( 100000, 3432247548, 6169362700, 450, 4 );
+     * // => { amount_out: 100110, invariant: 9600668971, d_iterations: 2, y_iterations: 1, delta: 0, is_wide: false }
+     * ```
+     */
+    static solver_result get_solver_result( const uint64_t amount_in, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee )
+    {
+        eosio::check(amount_in > 0, "curve.sx::get_amount_out: insufficient input amount");
+
+        solver_result result;
+        const uint64_t invariant = get_invariant<2>( { reserve_in, reserve_out }, amplifier, &result );
+        get_amount_out<2>( amount_in, { reserve_in, reserve_out }, 0, 1, amplifier, fee, invariant, &result );
+        return result;
+    }
+
+    /**
+     * ## STATIC `get_amount_in`
+     *
+     * Given an output amount, reserves pair, amplifier and a known invariant D, returns the input amount required
+     * Solves the invariant for the new reserve in, result is the smallest input for which `get_amount_out` returns at least `amount_out`
+     *
+     * ### params
+     *
+     * - `{uint64_t} amount_out` - amount output
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     * - `{uint64_t} invariant` - invariant D
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint64_t invariant = curve::get_invariant( reserve_in, reserve_out, amplifier );
+     * const uint64_t amount_in = curve::get_amount_in( amount_out, reserve_in, reserve_out, amplifier, fee, invariant );
+     * // => 100000
+     * ```
+     */
+    static uint64_t get_amount_in( const uint64_t amount_out, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee, const uint64_t invariant )
+    {
+        eosio::check(amount_out > 0, "curve.sx::get_amount_in: insufficient output amount");
+        eosio::check(amplifier > 0, "curve.sx::get_amount_in: invalid amplifier");
+        eosio::check(reserve_in > 0 && reserve_out > 0, "curve.sx::get_amount_in: insufficient liquidity");
+        eosio::check(reserve_in < (1LL << 62) - 1 && reserve_out < (1LL << 62) - 1, "curve.sx::get_amount_in: invalid reserves");
+        eosio::check(invariant > 0, "curve.sx::get_amount_in: invalid invariant");
+
+        // smallest amount out before trade fee which returns at least `amount_out`
+        uint64_t gross_out = (static_cast<uint128_t>(amount_out) * 10000 + 9999 - fee) / (10000 - fee);
+        while ( gross_out > amount_out && (gross_out - 1) - fee * static_cast<uint128_t>( gross_out - 1 ) / 10000 >= amount_out ) gross_out--;
+        check(reserve_out > gross_out, "curve.sx::get_amount_in: insufficient reserve out");
+
+        // new reserve in `z` is enough when the new reserve out `x` (largest x with x * (x + b) <= c) is at most `y`,
+        // exact integer predicate of `get_amount_out`, monotone since b grows and c shrinks with z
+        // c = D^3 / (8 * A * z) exceeds 128 bits for imbalanced reserves (small z), same flooring as the wide `get_amount_out`
+        const uint128_t D = invariant;
+        const uint64_t y = reserve_out - gross_out;
+        const auto get_c = [&]( const uint64_t z ) {
+            return safemath::div256( safemath::mul256( D * D / (z * 2), D ), uint128_t(amplifier) * 4 );
+        };
+        const auto is_enough = [&]( const uint64_t z ) {
+            const int128_t b = (int128_t) (z + (D / (amplifier * 2))) - (int128_t) D;
+            const int128_t y1_b = (int128_t) (y + 1) + b;
+            return y1_b > 0 && safemath::mul256( y + 1, static_cast<uint128_t>( y1_b ) ) > get_c( z );
+        };
+
+        // estimate z by solving the same quadratic equation with reserves swapped
+        const int128_t b = (int128_t) (y + (D / (amplifier * 2))) - (int128_t) D;
+        const uint128_t estimate = get_y( b, get_c( y ) ) + 1;
+        check(estimate < (1LL << 62) - 1, "curve.sx::get_amount_in: amount in overflow");
+
+        // gallop from the estimate to bracket the smallest z (lo == reserve_in means no input at all), then bisect
+        uint64_t lo, hi, step = 1;
+        if ( estimate > reserve_in && is_enough( estimate ) ) {
+            hi = estimate;
+            lo = hi - 1;
+            while ( lo > reserve_in && is_enough( lo ) ) {
+                hi = lo;
+                lo = lo > reserve_in + step ? lo - step : reserve_in;
+                step *= 2;
+            }
+        } else {
+            lo = estimate > reserve_in ? estimate : reserve_in;
+            hi = lo + 1;
+            while ( !is_enough( hi ) ) {
+                lo = hi;
+                hi += step;
+                step *= 2;
+                check(hi < (1LL << 62) - 1, "curve.sx::get_amount_in: amount in overflow");
+            }
         }
+        while ( hi - lo > 1 ) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if ( is_enough( mid ) ) hi = mid;
+            else lo = mid;
+        }
+        return hi - reserve_in;
+    }
 
-        // calculate x - new value for reserve_out by solving quadratic equation iteratively:
-        // x^2 + x * (sum' - (An^n - 1) * D / (An^n)) = D ^ (n + 1) / (n^(2n) * prod' * A), where n==2
-        // x^2 + b*x = c
-        check((uint64_t)D == D, "curve.sx::get_amount_out: d2 overflow");
-        const int128_t b = (int128_t) ((reserve_in + amount_in) + (D / (amplifier * 2))) - (int128_t) D;
-        const uint128_t c = D * D / ((reserve_in + amount_in) * 2) * D / (amplifier * 4);
-        uint128_t x = D, x_prev = 0;
-        i = MAX_ITERATIONS;
-        while ( x != x_prev && i--) {
-            x_prev = x;
-            x = (x * x + c) / (2 * x + b);
-        }
-        check(reserve_out > x, "curve.sx::get_amount_out: insufficient reserve out");
-        const uint64_t amount_out = reserve_out - (uint64_t)x;
-
-        return amount_out - fee * amount_out / 10000;
+    /**
+     * ## STATIC `get_amount_in`
+     *
+     * Given an output amount, reserves pair and amplifier, returns the input amount of the other asset based on Curve formula
+     *
+     * ### params
+     *
+     * - `{uint64_t} amount_out` - amount output
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint64_t amount_in = curve::get_amount_in( 100110, 3432247548, 6169362700, 450, 4 );
+     * // => 100000
+     * ```
+     */
+    static uint64_t get_amount_in( const uint64_t amount_out, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee )
+    {
+        eosio::check(amount_out > 0, "curve.sx::get_amount_in: insufficient output amount");
+
+        return get_amount_in( amount_out, reserve_in, reserve_out, amplifier, fee, get_invariant( reserve_in, reserve_out, amplifier ) );
+    }
+
+    /**
+     * ## STATIC `get_amounts_out`
+     *
+     * Given a list of input amounts, reserves pair and amplifier, returns the output amounts of the other asset
+     * Invariant D is solved once and shared by all input amounts
+     *
+     * ### params
+     *
+     * - `{vector<uint64_t>} amounts_in` - amounts input
+     * - `{uint64_t} reserve_in` - reserve input
+     * - `{uint64_t} reserve_out` - reserve output
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     *
+     * ### example
+     *
+     * ```c++
+     * const vector<uint64_t> amounts_out = curve::get_amounts_out( { 100000, 1000000 }, 3432247548, 6169362700, 450, 4 );
+     * // => [ 100110, 1001097 ]
+     * ```
+     */
+    static std::vector<uint64_t> get_amounts_out( const std::vector<uint64_t>& amounts_in, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint8_t fee )
+    {
+        const uint64_t invariant = get_invariant( reserve_in, reserve_out, amplifier );
+
+        std::vector<uint64_t> amounts_out;
+        amounts_out.reserve( amounts_in.size() );
+        for ( const uint64_t amount_in : amounts_in ) {
+            amounts_out.push_back( get_amount_out( amount_in, reserve_in, reserve_out, amplifier, fee, invariant ) );
+        }
+        return amounts_out;
     }
 }
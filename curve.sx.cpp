@@ -5,6 +5,9 @@
 
 #include "curve.sx.hpp"
 #include "src/actions.cpp"
+#include "src/pools.cpp"
+#include "src/fees.cpp"
+#include "src/routes.cpp"
 
 namespace sx {
 
@@ -14,52 +17,68 @@ namespace sx {
 [[eosio::on_notify("*::transfer")]]
 void curve::on_transfer( const name from, const name to, const asset quantity, const string memo )
 {
+    // ignore transfers (outgoing transfers of the contract itself return here without any table read)
+    if ( to != get_self() || from == "eosio.ram"_n ) return;
+
+    CURVE_PROFILE_SCOPE( "on_transfer" );
+
     // authenticate incoming `from` account
     require_auth( from );
 
-    // tables
+    // config & tables, loaded once for the whole action
     curve::config_table _config( get_self(), get_self().value );
-    curve::pairs_table _pairs( get_self(), get_self().value );
-
-    // config
-    check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
-    const name status = _config.get().status;
+    curve::pools_table _pools( get_self(), get_self().value );
+    curve::context ctx{ _config.get_or_default(), { get_self(), get_self().value }, {}, {}, {} };
+    check( ctx.config.token_contract.value, ERROR_CONFIG_NOT_EXISTS );
+    const name status = ctx.config.status;
     check( (status == "ok"_n || status == "withdraw"_n ), "curve::on_transfer: contract is under maintenance");
 
-    // ignore transfers
-    if ( to != get_self() || from == "eosio.ram"_n ) return;
-
     // user input params
-    const auto parsed_memo = parse_memo( memo );
+    const auto parsed_memo = parse_memo( ctx, memo );
     const extended_asset ext_in = { quantity, get_first_receiver() };
-    const bool is_liquidity = _pairs.find( quantity.symbol.code().raw() ) != _pairs.end();
+    const uint64_t symcode = quantity.symbol.code().raw();
 
     // only allow liquidity withdraws to be available
-    if ( status == "withdraw"_n ) check( is_liquidity, "curve::on_transfer: only accepts liquidity tokens during `withdraw` status");
+    if ( status == "withdraw"_n ) check( ctx.pairs.find( symcode ) != ctx.pairs.end() || _pools.find( symcode ) != _pools.end(), "curve::on_transfer: only accepts liquidity tokens during `withdraw` status");
 
     // add liquidity (memo required => "deposit,<pair_id>")
     if ( parsed_memo.action == "deposit"_n ) {
-        add_liquidity( from, parsed_memo.pair_ids[0], ext_in );
+        const symbol_code id = parsed_memo.pair_ids[0];
+        if ( _pools.find( id.raw() ) != _pools.end() ) add_pool_liquidity( from, id, ext_in );
+        else add_liquidity( from, id, ext_in );
 
-    // swap convert (memo required => "swap,<min_return>,<pair_ids>")
+    // swap convert (memo required => "swap,<min_return>,<pair_ids>[,<recipient>,<memo>]")
     } else if ( parsed_memo.action == "swap"_n) {
-        convert( from, ext_in, parsed_memo.pair_ids, parsed_memo.min_return );
+        convert( ctx, from, ext_in, parsed_memo.min_return, parsed_memo.recipient, parsed_memo.recipient_memo );
+
+    // exact output swap, unused input is refunded (memo required => "swapout,<amount_out>,<pair_ids>[,<recipient>,<memo>]")
+    } else if ( parsed_memo.action == "swapout"_n) {
+        swap_exact_out( ctx, from, ext_in, parsed_memo.min_return, parsed_memo.recipient, parsed_memo.recipient_memo );
+
+    // swap via multi-coin pool (memo required => "swappool,<min_return>,<pool_id>,<symcode_out>")
+    } else if ( parsed_memo.action == "swappool"_n) {
+        swap_pool( ctx.config, from, ext_in, parsed_memo.pair_ids[0], parsed_memo.symcode_out, parsed_memo.min_return );
 
     // withdraw liquidity (no memo required)
-    } else if ( is_liquidity ) {
+    } else if ( ctx.pairs.find( symcode ) != ctx.pairs.end() ) {
         withdraw_liquidity( from, ext_in );
 
+    // withdraw pool liquidity (no memo required)
+    } else if ( _pools.find( symcode ) != _pools.end() ) {
+        withdraw_pool_liquidity( from, ext_in );
+
     } else {
         check( false, ERROR_INVALID_MEMO );
     }
 
-    // accounts to be notified via inline action
-    notify();
+    // accounts to be notified via inline action (wildcard notifiers & subscribers of the pairs involved)
+    notify( ctx.config.notifiers, parsed_memo.pair_ids.size() ? parsed_memo.pair_ids : pair_ids_vector{ quantity.symbol.code() } );
 }
 
 [[eosio::action]]
 void curve::init( const name token_contract )
 {
+    CURVE_PROFILE_SCOPE( "init" );
     require_auth( get_self() );
 
     curve::config_table _config( get_self(), get_self().value );
@@ -77,56 +96,99 @@ void curve::init( const name token_contract )
 [[eosio::action]]
 void curve::reset()
 {
+    CURVE_PROFILE_SCOPE( "reset" );
     require_auth( get_self() );
 
     curve::config_table _config( get_self(), get_self().value );
     _config.remove();
 }
 
-void curve::convert( const name owner, const extended_asset ext_in, const vector<symbol_code> pair_ids, const int64_t min_return )
+void curve::convert( context& ctx, const name owner, const extended_asset ext_in, const int64_t min_return, const name recipient, const string_view recipient_memo )
 {
     // execute the trade by updating all involved pools
-    const extended_asset out = apply_trade( owner, ext_in, pair_ids );
+    const extended_asset out = apply_trade( ctx, owner, ext_in );
 
     // enforce minimum return (slippage protection)
     check(out.quantity.amount != 0 && out.quantity.amount >= min_return, "curve::convert: invalid minimum return");
 
-    // transfer amount to owner
-    transfer( get_self(), owner, out, get_self().to_string() + ": swap token" );
+    // transfer amount to owner (or memo `recipient`)
+    transfer_out( owner, recipient, recipient_memo, out );
 }
 
-extended_asset curve::apply_trade( const name owner, const extended_asset ext_quantity, const vector<symbol_code> pair_ids )
+void curve::swap_exact_out( context& ctx, const name owner, const extended_asset ext_in, const int64_t amount_out, const name recipient, const string_view recipient_memo )
 {
-    curve::pairs_table _pairs( get_self(), get_self().value );
-    curve::config_table _config( get_self(), get_self().value );
-    check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
-    auto config = _config.get();
+    // output symbol of the route (already chained by `addroute` for registered routes)
+    symbol symbol_out = ctx.route_out.get_symbol();
+    if ( !ctx.route_out.get_contract().value ) {
+        symbol_out = ext_in.quantity.symbol;
+        for ( const auto itr : ctx.route ) {
+            check( itr->reserve0.quantity.symbol == symbol_out || itr->reserve1.quantity.symbol == symbol_out, "curve::swap_exact_out: invalid extended symbol");
+            symbol_out = itr->reserve0.quantity.symbol == symbol_out ? itr->reserve1.quantity.symbol : itr->reserve0.quantity.symbol;
+        }
+    }
+
+    // required input, calculated backwards from the last hop
+    asset required = { amount_out, symbol_out };
+    for ( size_t i = ctx.route.size(); i-- > 0; ) {
+        const auto& pairs = *ctx.route[i];
+        required = get_amount_in( required, pairs, ctx.config, get_amplifier( pairs ) );
+    }
+    check( required.amount <= ext_in.quantity.amount, "curve::swap_exact_out: insufficient input, requires " + required.to_string() );
+
+    // execute the trade with the required input only
+    const extended_asset out = apply_trade( ctx, owner, { required, ext_in.contract } );
+    check( out.quantity.amount >= amount_out, "curve::swap_exact_out: invalid minimum return");
+
+    // refund unused input to owner & transfer amount to owner (or memo `recipient`)
+    const extended_asset refund = ext_in - extended_asset{ required, ext_in.contract };
+    if ( refund.quantity.amount ) transfer( get_self(), owner, refund, get_self().to_string() + ": refund" );
+    transfer_out( owner, recipient, recipient_memo, out );
+}
+
+// swap output goes to the memo `recipient` with its memo when set, otherwise back to the owner
+void curve::transfer_out( const name owner, const name recipient, const string_view recipient_memo, const extended_asset out )
+{
+    if ( !recipient.value ) return transfer( get_self(), owner, out, get_self().to_string() + ": swap token" );
+    transfer( get_self(), recipient, out, recipient_memo.size() ? string( recipient_memo ) : get_self().to_string() + ": swap token" );
+}
+
+extended_asset curve::apply_trade( context& ctx, const name owner, const extended_asset ext_quantity )
+{
+    const auto& config = ctx.config;
 
     // initial quantities
     extended_asset ext_out;
     extended_asset ext_in = ext_quantity;
+    vector<swap_hop> hops;
+    hops.reserve( ctx.route.size() );
 
-    // iterate over each liquidity pool per each `pair_id` provided in swap memo
-    for ( const symbol_code pair_id : pair_ids ) {
-        const auto& pairs = _pairs.get( pair_id.raw(), "curve::apply_trade: `pair_id` does not exist");
+    // registered routes were chained by `addroute`, only their input is checked
+    const bool is_registered = ctx.route_in.get_contract().value;
+    if ( is_registered ) check( ctx.route_in == ext_in.get_extended_symbol(), "curve::apply_trade: invalid extended symbol");
+
+    // iterate over each liquidity pool found while parsing the `pair_ids` of the swap memo
+    for ( const auto itr : ctx.route ) {
+        const auto& pairs = *itr;
+        const symbol_code pair_id = pairs.id;
         const bool is_in = pairs.reserve0.quantity.symbol == ext_in.quantity.symbol;
         const extended_asset reserve_in = is_in ? pairs.reserve0 : pairs.reserve1;
         const extended_asset reserve_out = is_in ? pairs.reserve1 : pairs.reserve0;
 
         // validate input quantity & reserves
-        check(reserve_in.get_extended_symbol() == ext_in.get_extended_symbol(), "curve::apply_trade: invalid extended symbol");
+        if ( !is_registered ) check(reserve_in.get_extended_symbol() == ext_in.get_extended_symbol(), "curve::apply_trade: invalid extended symbol");
         check(reserve_in.quantity.amount != 0 && reserve_out.quantity.amount != 0, "curve::apply_trade: empty pool reserves");
 
         // calculate out
-        ext_out = { get_amount_out( ext_in.quantity, pair_id, get_self() ), reserve_out.contract };
+        const uint64_t amplifier = get_amplifier( pairs );
+        ext_out = { get_amount_out( ext_in.quantity, pairs, config, amplifier ), reserve_out.contract };
 
-        // send protocol fees to fee account
+        // protocol & trade fees
         const extended_asset protocol_fee = { ext_in.quantity.amount * config.protocol_fee / 10000, ext_in.get_extended_symbol() };
         const extended_asset trade_fee = { ext_in.quantity.amount * config.trade_fee / 10000, ext_in.get_extended_symbol() };
         const extended_asset fee = protocol_fee + trade_fee;
 
         // modify reserves
-        _pairs.modify( pairs, get_self(), [&]( auto & row ) {
+        ctx.pairs.modify( itr, get_self(), [&]( auto & row ) {
             // calculate last price
             const double price = calculate_price( ext_out.quantity, ext_in.quantity );
 
@@ -141,38 +203,53 @@ extended_asset curve::apply_trade( const name owner, const extended_asset ext_qu
                 row.volume1 += ext_in.quantity;
                 row.price1_last = price;
             }
-            row.amplifier = get_amplifier( pair_id, get_self() );
+            update_amplifier( row );
+            update_invariant( row );
             row.virtual_price = calculate_virtual_price( row.reserve0.quantity, row.reserve1.quantity, row.liquidity.quantity );
             row.trades += 1;
             row.last_updated = current_time_point();
-
-            // swap log
-            curve::swaplog_action swaplog( get_self(), { get_self(), "active"_n });
-            swaplog.send( pair_id, owner, "swap"_n, ext_in.quantity, ext_out.quantity, fee.quantity, price, row.reserve0.quantity, row.reserve1.quantity );
+            hops.push_back({ pair_id, ext_in.quantity, ext_out.quantity, fee.quantity, price, row.reserve0.quantity, row.reserve1.quantity });
         });
-        // send protocol fees
-        if ( protocol_fee.quantity.amount ) transfer( get_self(), config.fee_account, protocol_fee, get_self().to_string() + ": protocol fee");
+        // accrue protocol fees (paid out by `claimfees`)
+        if ( protocol_fee.quantity.amount ) accrue_fee( protocol_fee );
 
         // swap input as output to prepare for next conversion
         ext_in = ext_out;
     }
 
+    // swap log: single hop swaps keep `swaplog`, multi-hop routes are logged (& notified) once
+    if ( hops.size() == 1 ) {
+        const swap_hop& hop = hops[0];
+        curve::swaplog_action swaplog( get_self(), { get_self(), "active"_n });
+        CURVE_PROFILE_COUNT( swaplog, 1 );
+        swaplog.send( hop.pair_id, owner, "swap"_n, hop.quantity_in, hop.quantity_out, hop.fee, hop.trade_price, hop.reserve0, hop.reserve1 );
+    } else {
+        curve::routelog_action routelog( get_self(), { get_self(), "active"_n });
+        CURVE_PROFILE_COUNT( routelog, 1 );
+        routelog.send( owner, "swap"_n, hops );
+    }
+
     return ext_out;
 }
 
 [[eosio::action]]
 void curve::deposit( const name owner, const symbol_code pair_id, const optional<int64_t> min_amount )
 {
+    CURVE_PROFILE_SCOPE( "deposit" );
     require_auth( owner );
 
     curve::config_table _config( get_self(), get_self().value );
     curve::pairs_table _pairs( get_self(), get_self().value );
+    curve::pools_table _pools( get_self(), get_self().value );
     curve::orders_table _orders( get_self(), pair_id.raw() );
 
     // configs
     check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
     auto config = _config.get();
 
+    // multi-coin pool deposit
+    if ( _pools.find( pair_id.raw() ) != _pools.end() ) return deposit_pool( owner, pair_id, min_amount );
+
     // get current order & pairs
     auto & pair = _pairs.get( pair_id.raw(), "curve::deposit: `pair_id` does not exist");
     auto & orders = _orders.get( owner.value, "curve::deposit: no deposits available for this user");
@@ -189,14 +266,12 @@ void curve::deposit( const name owner, const symbol_code pair_id, const optional
     const int128_t reserve1 = pair.reserve1.quantity.amount ? mul_amount(pair.reserve1.quantity.amount, precision_norm, sym1.precision()) : 1;
     const int128_t reserves = reserve0 + reserve1;
 
-    // get owner order and calculate payment
+    // get owner order
     const int128_t amount0 = mul_amount(orders.quantity0.quantity.amount, precision_norm, sym0.precision());
     const int128_t amount1 = mul_amount(orders.quantity1.quantity.amount, precision_norm, sym1.precision());
-    const int128_t payment = amount0 + amount1;
 
     // calculate actual amounts to deposit
-    const int128_t deposit0 = (amount0 * reserves <= reserve0 * payment) ? amount0 : (amount1 * reserve0 / reserve1);
-    const int128_t deposit1 = (amount0 * reserves <= reserve0 * payment) ? (amount0 * reserve1 / reserve0) : amount1;
+    const auto [ deposit0, deposit1 ] = get_deposit_amounts( amount0, amount1, reserve0, reserve1 );
 
     // send back excess deposit to owner
     if (deposit0 < amount0) {
@@ -224,9 +299,12 @@ void curve::deposit( const name owner, const symbol_code pair_id, const optional
         row.reserve0 += ext_deposit0;
         row.reserve1 += ext_deposit1;
         row.liquidity += issued;
+        update_amplifier( row );
+        update_invariant( row );
 
         // log liquidity change
         curve::liquiditylog_action liquiditylog( get_self(), { get_self(), "active"_n });
+        CURVE_PROFILE_COUNT( liquiditylog, 1 );
         liquiditylog.send( pair_id, owner, "deposit"_n, issued.quantity, ext_deposit0.quantity, ext_deposit1.quantity, row.liquidity.quantity, row.reserve0.quantity, row.reserve1.quantity );
     });
 
@@ -245,8 +323,13 @@ void curve::deposit( const name owner, const symbol_code pair_id, const optional
 [[eosio::action]]
 void curve::cancel( const name owner, const symbol_code pair_id )
 {
+    CURVE_PROFILE_SCOPE( "cancel" );
     if ( !has_auth( get_self() )) require_auth( owner );
 
+    // multi-coin pool orders
+    curve::pools_table _pools( get_self(), get_self().value );
+    if ( _pools.find( pair_id.raw() ) != _pools.end() ) return cancel_pool( owner, pair_id );
+
     curve::orders_table _orders( get_self(), pair_id.raw() );
     auto & orders = _orders.get( owner.value, "curve::cancel: no deposits for this user in this pool");
     if ( orders.quantity0.quantity.amount ) transfer( get_self(), owner, orders.quantity0, get_self().to_string() + ": cancel");
@@ -258,11 +341,18 @@ void curve::cancel( const name owner, const symbol_code pair_id )
 [[eosio::action]]
 void curve::removepair( const symbol_code pair_id )
 {
+    CURVE_PROFILE_SCOPE( "removepair" );
     require_auth( get_self() );
 
     curve::pairs_table _pairs( get_self(), get_self().value );
     auto & pair = _pairs.get( pair_id.raw(), "curve::removepair: [pair_id] does not exist");
     check( pair.liquidity.quantity.amount == 0, "curve::removepair: liquidity amount must be empty");
+
+    // registered routes skip pair validation, their pairs can only be removed once the routes are deleted
+    curve::routes_table _routes( get_self(), get_self().value );
+    for ( const auto& route : _routes ) {
+        check( std::find( route.pair_ids.begin(), route.pair_ids.end(), pair_id ) == route.pair_ids.end(), "curve::removepair: `pair_id` is used by a route (`delroute` first)");
+    }
     _pairs.erase( pair );
 }
 
@@ -295,12 +385,7 @@ void curve::withdraw_liquidity( const name owner, const extended_asset value )
     const int64_t retire_amount = rex::retire( payment, reserves, supply );
 
     // get owner order and calculate payment
-    int64_t amount0 = static_cast<int64_t>( retire_amount * reserve0 / reserves );
-    int64_t amount1 = static_cast<int64_t>( retire_amount * reserve1 / reserves );
-    if (amount0 == reserve0 || amount1 == reserve1) {         //deal with rounding error on final withdrawal
-        amount0 = static_cast<int64_t>( reserve0 );
-        amount1 = static_cast<int64_t>( reserve1 );
-    }
+    const auto [ amount0, amount1 ] = get_withdraw_amounts( retire_amount, reserve0, reserve1 );
     const extended_asset out0 = { div_amount(amount0, precision_norm, sym0.precision()), ext_sym0 };
     const extended_asset out1 = { div_amount(amount1, precision_norm, sym1.precision()), ext_sym1 };
     check( out0.quantity.amount || out1.quantity.amount, "curve::withdraw_liquidity: withdraw amount too small");
@@ -310,9 +395,12 @@ void curve::withdraw_liquidity( const name owner, const extended_asset value )
         row.reserve0 -= out0;
         row.reserve1 -= out1;
         row.liquidity -= value;
+        update_amplifier( row );
+        update_invariant( row );
 
         // log liquidity change
         curve::liquiditylog_action liquiditylog( get_self(), { get_self(), "active"_n });
+        CURVE_PROFILE_COUNT( liquiditylog, 1 );
         liquiditylog.send( pair_id, owner, "withdraw"_n, value.quantity, -out0.quantity, -out1.quantity, row.liquidity.quantity, row.reserve0.quantity, row.reserve1.quantity );
     });
 
@@ -353,47 +441,76 @@ void curve::add_liquidity( const name owner, const symbol_code pair_id, const ex
     else _orders.modify( itr, get_self(), insert );
 }
 
-// increase/decrease amplifier of given pair id
+// increase/decrease amplifier of given pair id (ramp state is stored in the pair row)
 [[eosio::action]]
 void curve::ramp( const symbol_code pair_id, const uint64_t target_amplifier, const int64_t minutes )
 {
+    CURVE_PROFILE_SCOPE( "ramp" );
     require_auth( get_self() );
 
-    curve::ramp_table _ramp_table( get_self(), get_self().value );
     curve::pairs_table _pairs( get_self(), get_self().value );
-    auto pair = _pairs.get(pair_id.raw(), "curve::ramp: `pair_id` does not exist in `pairs`");
+    auto & pair = _pairs.get(pair_id.raw(), "curve::ramp: `pair_id` does not exist in `pairs`");
 
     // validation
     check( target_amplifier > 0 && target_amplifier <= MAX_AMPLIFIER, "curve::ramp: target amplifier should be within within valid range");
     check( minutes > 0, "curve::ramp: minutes should be above 0");
     check( minutes * 60 >= MIN_RAMP_TIME, "curve::ramp: minimum ramp timeframe must exceed " + to_string(MIN_RAMP_TIME) + " seconds");
 
-    auto insert = [&]( auto & row ) {
-        row.pair_id = pair_id;
-        row.start_amplifier = pair.amplifier;
-        row.target_amplifier = target_amplifier;
-        row.start_time = current_time_point();
-        row.end_time = current_time_point() + eosio::minutes(minutes);
-    };
-
-    auto itr = _ramp_table.find(pair_id.raw());
-    if ( itr == _ramp_table.end() ) _ramp_table.emplace( get_self(), insert );
-    else _ramp_table.modify( itr, get_self(), insert );
+    // ramp from the current amplifier (an active ramp is replaced)
+    const uint64_t start_amplifier = get_amplifier( pair );
+    _pairs.modify( pair, get_self(), [&]( auto & row ) {
+        set_ramp( row, start_amplifier, target_amplifier, current_time_point(), current_time_point() + eosio::minutes(minutes) );
+    });
 }
 
+// stop the active ramp at the current amplifier
 [[eosio::action]]
 void curve::stopramp( const symbol_code pair_id )
 {
+    CURVE_PROFILE_SCOPE( "stopramp" );
+    require_auth( get_self() );
+
+    curve::pairs_table _pairs( get_self(), get_self().value );
+    auto & pair = _pairs.get(pair_id.raw(), "curve::stopramp: `pair_id` does not exist in `pairs`");
+    check( get_ramp_end_time( pair ), "curve::stopramp: `pair_id` has no active ramp");
+
+    const uint64_t amplifier = get_amplifier( pair );
+    _pairs.modify( pair, get_self(), [&]( auto & row ) {
+        row.amplifier = amplifier;
+        clear_ramp( row );
+    });
+}
+
+// one-shot upgrade: move the ramps of the legacy `ramp` table into `pairs` & erase the legacy rows
+// (push with the contract upgrade, until then legacy ramps are not applied)
+[[eosio::action]]
+void curve::migrate()
+{
+    CURVE_PROFILE_SCOPE( "migrate" );
     require_auth( get_self() );
 
     curve::ramp_table _ramp( get_self(), get_self().value );
-    auto & ramp = _ramp.get(pair_id.raw(), "curve::stopramp: `pair_id` does not exist in `ramp` table");
-    _ramp.erase( ramp );
+    curve::pairs_table _pairs( get_self(), get_self().value );
+
+    for ( auto itr = _ramp.begin(); itr != _ramp.end(); ) {
+        auto pair = _pairs.find( itr->pair_id.raw() );
+
+        // pairs which have been ramped or stopped since the upgrade keep their own ramp
+        if ( pair != _pairs.end() && !pair->ramp_end_time.has_value() ) {
+            _pairs.modify( pair, get_self(), [&]( auto & row ) {
+                set_ramp( row, itr->start_amplifier, itr->target_amplifier, itr->start_time, itr->end_time );
+                update_amplifier( row );
+                update_invariant( row );
+            });
+        }
+        itr = _ramp.erase( itr );
+    }
 }
 
 [[eosio::action]]
 void curve::setfee( const uint8_t trade_fee, const optional<uint8_t> protocol_fee, const optional<name> fee_account )
 {
+    CURVE_PROFILE_SCOPE( "setfee" );
     require_auth( get_self() );
 
     // config
@@ -420,21 +537,102 @@ void curve::setfee( const uint8_t trade_fee, const optional<uint8_t> protocol_fe
 [[eosio::action]]
 void curve::setnotifiers( const vector<name> notifiers )
 {
+    CURVE_PROFILE_SCOPE( "setnotifiers" );
     require_auth( get_self() );
 
+    // validate once, notifications never look up accounts
+    set<name> unique;
     for ( const name notifier : notifiers ) {
         check( is_account( notifier ), "curve::setnotifiers: `notifier` does not exist");
+        check( unique.insert( notifier ).second, "curve::setnotifiers: duplicate `notifier`");
     }
+    set_notifiers( notifiers );
+}
+
+// wildcard notifiers (all pairs & pools), kept in `config` for `on_transfer` & in the compact `notifiers` copy for log actions
+void curve::set_notifiers( const vector<name> notifiers )
+{
     curve::config_table _config( get_self(), get_self().value );
     check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
     auto config = _config.get();
     config.notifiers = notifiers;
     _config.set( config, get_self() );
+
+    curve::notifiers_table _notifiers( get_self(), get_self().value );
+    auto row = _notifiers.get_or_default();
+    row.accounts = notifiers;
+    _notifiers.set( row, get_self() );
+}
+
+// subscribe `notifier` to the notifications of `pair_id` (pair or pool), an empty `pair_id` subscribes to all pairs
+[[eosio::action]]
+void curve::subscribe( const name notifier, const symbol_code pair_id )
+{
+    CURVE_PROFILE_SCOPE( "subscribe" );
+    require_auth( get_self() );
+
+    check( is_account( notifier ), "curve::subscribe: `notifier` does not exist");
+
+    // wildcard
+    if ( !pair_id.raw() ) {
+        curve::config_table _config( get_self(), get_self().value );
+        vector<name> notifiers = _config.get_or_default().notifiers;
+        check( std::find( notifiers.begin(), notifiers.end(), notifier ) == notifiers.end(), "curve::subscribe: `notifier` already subscribed");
+        notifiers.push_back( notifier );
+        return set_notifiers( notifiers );
+    }
+
+    curve::pairs_table _pairs( get_self(), get_self().value );
+    curve::pools_table _pools( get_self(), get_self().value );
+    curve::subscribers_table _subscribers( get_self(), pair_id.raw() );
+    check( _pairs.find( pair_id.raw() ) != _pairs.end() || _pools.find( pair_id.raw() ) != _pools.end(), "curve::subscribe: `pair_id` does not exist");
+    check( _subscribers.find( notifier.value ) == _subscribers.end(), "curve::subscribe: `notifier` already subscribed");
+
+    _subscribers.emplace( get_self(), [&]( auto & row ) {
+        row.notifier = notifier;
+    });
+}
+
+[[eosio::action]]
+void curve::unsubscribe( const name notifier, const symbol_code pair_id )
+{
+    CURVE_PROFILE_SCOPE( "unsubscribe" );
+    require_auth( get_self() );
+
+    // wildcard
+    if ( !pair_id.raw() ) {
+        curve::config_table _config( get_self(), get_self().value );
+        vector<name> notifiers = _config.get_or_default().notifiers;
+        const auto itr = std::find( notifiers.begin(), notifiers.end(), notifier );
+        check( itr != notifiers.end(), "curve::unsubscribe: `notifier` is not subscribed");
+        notifiers.erase( itr );
+        return set_notifiers( notifiers );
+    }
+
+    curve::subscribers_table _subscribers( get_self(), pair_id.raw() );
+    auto & row = _subscribers.get( notifier.value, "curve::unsubscribe: `notifier` is not subscribed");
+    _subscribers.erase( row );
+}
+
+// disable when `notifiers` only need the transfers & actions: `on_transfer` already notifies them in the same transaction
+// (`deposit` logs & pair subscribers are always notified)
+[[eosio::action]]
+void curve::setlognotify( const bool notify_logs )
+{
+    CURVE_PROFILE_SCOPE( "setlognotify" );
+    require_auth( get_self() );
+
+    curve::notifiers_table _notifiers( get_self(), get_self().value );
+    auto row = _notifiers.get_or_default();
+    row.accounts = curve::config_table( get_self(), get_self().value ).get_or_default().notifiers;
+    row.notify_logs = notify_logs;
+    _notifiers.set( row, get_self() );
 }
 
 [[eosio::action]]
 void curve::setstatus( const name status )
 {
+    CURVE_PROFILE_SCOPE( "setstatus" );
     require_auth( get_self() );
 
     curve::config_table _config( get_self(), get_self().value );
@@ -447,12 +645,15 @@ void curve::setstatus( const name status )
 [[eosio::action]]
 void curve::createpair( const name creator, const symbol_code pair_id, const extended_symbol reserve0, const extended_symbol reserve1, const uint64_t amplifier )
 {
+    CURVE_PROFILE_SCOPE( "createpair" );
+
     // `creator` must be contract
     check( creator == get_self(), "curve::createpair: only contract admin can create pair");
     require_auth( creator );
 
     // tables
     curve::pairs_table _pairs( get_self(), get_self().value );
+    curve::pools_table _pools( get_self(), get_self().value );
     curve::config_table _config( get_self(), get_self().value );
     check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
     const name token_contract = _config.get().token_contract;
@@ -469,6 +670,7 @@ void curve::createpair( const name creator, const symbol_code pair_id, const ext
     check( token::get_supply( contract0, sym0.code() ).symbol == sym0, "curve::createpair: reserve0 extended symbol mismatch supply" );
     check( token::get_supply( contract1, sym1.code() ).symbol == sym1, "curve::createpair: reserve1 extended symbol mismatch supply" );
     check( _pairs.find( pair_id.raw() ) == _pairs.end(), "curve::createpair: `pair_id` already exists" );
+    check( _pools.find( pair_id.raw() ) == _pools.end(), "curve::createpair: `pair_id` already exists in `pools`" );
     check( amplifier > 0 && amplifier <= MAX_AMPLIFIER, "curve::createpair: invalid amplifier" );
 
     // create liquidity token
@@ -490,6 +692,8 @@ void curve::createpair( const name creator, const symbol_code pair_id, const ext
         row.reserve1 = { 0, reserve1 };
         row.liquidity = { 0, liquidity };
         row.amplifier = amplifier;
+        update_invariant( row );
+        clear_ramp( row );
         row.volume0 = { 0, sym0 };
         row.volume1 = { 0, sym1 };
         row.last_updated = current_time_point();
@@ -518,32 +722,70 @@ double curve::calculate_price( const asset value0, const asset value1 )
 // Memo schemas
 // ============
 // Swap: `swap,<min_return>,<pair_ids>` (ex: "swap,0,SXA" )
+// Swap to recipient: `swap,<min_return>,<pair_ids>,<recipient>[,<memo>]` (ex: "swap,0,SXA,myreceiver,order 123" ), also `swapout`
+// Swap registered route: `swap,<min_return>,@<route_id>` (ex: "swap,0,@1" )
+// Swap exact output: `swapout,<amount_out>,<pair_ids>` (ex: "swapout,100000,SXA" )
+// Swap pool: `swappool,<min_return>,<pool_id>,<symcode_out>` (ex: "swappool,0,ABC,C" )
 // Deposit: `deposit,<pair_id>` (ex: "deposit,SXA")
 // Withdrawal: `` (empty)
-curve::memo_schema curve::parse_memo( const string memo )
+curve::memo_schema curve::parse_memo( context& ctx, const string_view memo )
 {
     if (memo == "") return {};
 
-    // split memo into parts
-    const vector<string> parts = sx::utils::split(memo, ",");
-    check(parts.size() <= 3, ERROR_INVALID_MEMO );
+    // split memo into parts (views of `memo`, no copies)
+    string_view rest = memo;
+    std::array<string_view, 4> parts;
+    size_t size = 0;
+    while ( size < parts.size() ) {
+        const string_view part = sx::utils::next_token( rest, ',' );
+        if ( part.empty() ) break;
+        parts[ size++ ] = part;
+    }
 
     // memo result
     memo_schema result;
     result.action = sx::utils::parse_name(parts[0]);
     result.min_return = 0;
+    const bool is_swap = result.action == "swap"_n || result.action == "swapout"_n;
+
+    // swaps keep the rest of the memo as `recipient` memo (commas included)
+    if ( !is_swap ) check( sx::utils::next_token( rest, ',' ).empty(), ERROR_INVALID_MEMO );
+    if ( result.action != "swappool"_n && !is_swap ) check(size <= 3, ERROR_INVALID_MEMO );
 
-    // swap action
-    if ( result.action == "swap"_n ) {
-        result.pair_ids = parse_memo_pair_ids( parts[2] );
-        check( sx::utils::is_digit( parts[1] ), ERROR_INVALID_MEMO );
-        result.min_return = std::stoll( parts[1] );
+    // swap action (`swapout` amount out is kept as `min_return`)
+    if ( is_swap ) {
+        if ( parts[2].size() && parts[2][0] == '@' ) result.pair_ids = parse_memo_route( ctx, parts[2].substr( 1 ) );
+        else result.pair_ids = parse_memo_pair_ids( ctx, parts[2] );
+        result.min_return = sx::utils::parse_digits( parts[1] );
         check( result.min_return >= 0, ERROR_INVALID_MEMO );
+        if ( result.action == "swapout"_n ) check( result.min_return > 0, ERROR_INVALID_MEMO );
         check( result.pair_ids.size() >= 1, ERROR_INVALID_MEMO );
 
+        // optional output recipient & its transfer memo
+        if ( size == 4 ) {
+            result.recipient = sx::utils::parse_name( parts[3] );
+            result.recipient_memo = rest;
+            check( result.recipient.value, ERROR_INVALID_MEMO );
+        }
+
+    // swap via multi-coin pool
+    } else if ( result.action == "swappool"_n ) {
+        curve::pools_table _pools( get_self(), get_self().value );
+        check( size == 4, ERROR_INVALID_MEMO );
+        result.min_return = sx::utils::parse_digits( parts[1] );
+        check( result.min_return >= 0, ERROR_INVALID_MEMO );
+        const symbol_code pool_id = sx::utils::parse_symbol_code( parts[2] );
+        result.symcode_out = sx::utils::parse_symbol_code( parts[3] );
+        check( pool_id.raw() && result.symcode_out.raw(), ERROR_INVALID_MEMO );
+        check( _pools.find( pool_id.raw() ) != _pools.end(), "curve::parse_memo: `pool_id` does not exist");
+        result.pair_ids = { pool_id };
+
     // deposit action
     } else if ( result.action == "deposit"_n ) {
-        result.pair_ids = parse_memo_pair_ids( parts[1] );
+        curve::pools_table _pools( get_self(), get_self().value );
+        const symbol_code pool_id = sx::utils::parse_symbol_code( parts[1] );
+        if ( pool_id.raw() && _pools.find( pool_id.raw() ) != _pools.end() ) result.pair_ids = { pool_id };
+        else result.pair_ids = parse_memo_pair_ids( ctx, parts[1] );
         check( result.pair_ids.size() == 1, ERROR_INVALID_MEMO );
     }
     return result;
@@ -553,19 +795,22 @@ curve::memo_schema curve::parse_memo( const string memo )
 // ============
 // Single: `<pair_id>` (ex: "SXA")
 // Multiple: `<pair_id>-<pair_id>` (ex: "SXA-SXB")
-vector<symbol_code> curve::parse_memo_pair_ids( const string memo )
+// found pairs are kept in `ctx.route` for `apply_trade`
+curve::pair_ids_vector curve::parse_memo_pair_ids( context& ctx, const string_view memo )
 {
-    curve::pairs_table _pairs( get_self(), get_self().value );
-
-    set<symbol_code> duplicates;
-    vector<symbol_code> pair_ids;
-    for ( const string str : sx::utils::split(memo, "-") ) {
+    pair_ids_vector pair_ids;
+    string_view rest = memo;
+    for ( string_view str = sx::utils::next_token( rest, '-' ); !str.empty(); str = sx::utils::next_token( rest, '-' ) ) {
         const symbol_code symcode = sx::utils::parse_symbol_code( str );
         check( symcode.raw(), ERROR_INVALID_MEMO );
-        check( _pairs.find( symcode.raw() ) != _pairs.end(), "curve::parse_memo_pair_ids: `pair_id` does not exist");
+        const auto itr = ctx.pairs.find( symcode.raw() );
+        check( itr != ctx.pairs.end(), "curve::parse_memo_pair_ids: `pair_id` does not exist");
+
+        // linear scan, routes are a few hops
+        check( std::find( pair_ids.begin(), pair_ids.end(), symcode ) == pair_ids.end(), "curve::parse_memo_pair_ids: invalid duplicate `pair_ids`");
+        check( pair_ids.size() < pair_ids.capacity(), ERROR_INVALID_MEMO );
         pair_ids.push_back( symcode );
-        check( !duplicates.count( symcode ), "curve::parse_memo_pair_ids: invalid duplicate `pair_ids`");
-        duplicates.insert( symcode );
+        ctx.route.push_back( itr );
     }
     return pair_ids;
 }
@@ -577,4 +822,22 @@ void curve::calculate( const uint64_t amount, const uint64_t reserve_in, const u
     check(false, "current get_amount_out(amount: " + to_string(amount) + ", amp: " + to_string(amplifier) + "  ): " + to_string(out) );
 }
 
+// debug: solver telemetry of a swap quote on `pair_id`, follows the trade path (stored invariant unless the amplifier has been ramped since or the swap is from reserve1)
+[[eosio::action]]
+void curve::solverstats( const symbol_code pair_id, const asset quantity_in )
+{
+    curve::config_table _config( get_self(), get_self().value );
+    curve::pairs_table _pairs( get_self(), get_self().value );
+    check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
+    const auto config = _config.get();
+    const auto& pairs = _pairs.get( pair_id.raw(), "curve::solverstats: `pair_id` does not exist");
+    const uint64_t amplifier = get_amplifier( pairs );
+
+    Curve::solver_result result;
+    get_amount_out( quantity_in, pairs, config, amplifier, &result );
+    check(false, "solverstats(pair_id: " + pair_id.to_string() + ", amp: " + to_string(amplifier) + "): amount_out=" + to_string(result.amount_out)
+        + " invariant=" + to_string(result.invariant) + " d_iterations=" + to_string(result.d_iterations) + " y_iterations=" + to_string(result.y_iterations)
+        + " delta=" + to_string(result.delta) + " is_wide=" + to_string(result.is_wide) );
+}
+
 } // namespace sx
\ No newline at end of file
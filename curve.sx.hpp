@@ -4,7 +4,11 @@
 #include <eosio/time.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
 
+#include <sx.utils/utils.hpp>
+
+#include "src/profile.hpp"
 #include "curve.hpp"
 
 #include <optional>
@@ -20,9 +24,12 @@ static constexpr uint32_t MIN_RAMP_TIME = 86400;
 static constexpr uint32_t MAX_AMPLIFIER = 1000000;
 static constexpr uint32_t MAX_PROTOCOL_FEE = 100;
 static constexpr uint32_t MAX_TRADE_FEE = 50;
+static constexpr uint8_t MIN_POOL_RESERVES = 3;
+static constexpr uint8_t MAX_POOL_RESERVES = 4;
+static constexpr size_t MAX_PAIR_IDS = 125; // "swap,0,A-B-..." within the 256 byte `eosio.token` memo
 
 // Error messages
-static string ERROR_INVALID_MEMO = "curve: invalid memo (ex: \"swap,<min_return>,<pair_ids>\" or \"deposit,<pair_id>\"";
+static string ERROR_INVALID_MEMO = "curve: invalid memo (ex: \"swap,<min_return>,<pair_ids>[,<recipient>,<memo>]\", \"swap,<min_return>,@<route_id>\", \"swapout,<amount_out>,<pair_ids>\", \"swappool,<min_return>,<pool_id>,<symcode_out>\" or \"deposit,<pair_id>\"";
 static string ERROR_CONFIG_NOT_EXISTS = "curve: contract is under maintenance";
 
 namespace sx {
@@ -66,7 +73,54 @@ public:
         name                token_contract;
         vector<name>        notifiers;
     };
-    typedef eosio::singleton< "config"_n, config_row > config_table;
+    typedef profile::singleton< "config"_n, config_row > config_table;
+
+    /**
+     * ## TABLE `notifiers`
+     *
+     * Compact copy of the notifiers validated by `setnotifiers`, read by the log actions instead of `config`
+     *
+     * - `{vector<name>} accounts` - existing & unique accounts to be notified via inline action
+     * - `{bool} notify_logs` - log actions emitted by transfers (`swaplog`, `routelog`, withdraw `liquiditylog`) notify `accounts` (see `setlognotify`)
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "accounts": ["stats.sx"],
+     *   "notify_logs": true
+     * }
+     * ```
+     */
+    struct [[eosio::table("notifiers")]] notifiers_row {
+        vector<name>        accounts;
+        bool                notify_logs = true;
+    };
+    typedef profile::singleton< "notifiers"_n, notifiers_row > notifiers_table;
+
+    /**
+     * ## TABLE `subscribers`
+     *
+     * Notifiers subscribed to a single pair or pool (wildcard notifiers are `config.notifiers`)
+     *
+     * *scope*: `pair_id` (symbol_code)
+     *
+     * - `{name} notifier` - account to be notified via inline action
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "notifier": "stats.sx"
+     * }
+     * ```
+     */
+    struct [[eosio::table("subscribers")]] subscribers_row {
+        name                notifier;
+
+        uint64_t primary_key() const { return notifier.value; }
+    };
+    typedef profile::multi_index< "subscribers"_n, subscribers_row> subscribers_table;
 
     /**
      * ## TABLE `orders`
@@ -94,7 +148,7 @@ public:
 
         uint64_t primary_key() const { return owner.value; }
     };
-    typedef eosio::multi_index< "orders"_n, orders_row> orders_table;
+    typedef profile::multi_index< "orders"_n, orders_row> orders_table;
 
     /**
      * ## TABLE `pairs`
@@ -110,6 +164,12 @@ public:
      * - `{asset} volume1` - cumulative incoming trading volume for reserve1
      * - `{uint64_t} trades` - cumulative trades count
      * - `{time_point_sec} last_updated` - last updated timestamp
+     * - `{binary_extension<uint64_t>} invariant` - invariant D of reserves normalized to `MAX_PRECISION` (missing from rows created before it was stored, recalculated on first touch)
+     * - `{binary_extension<uint64_t>} invariant_amplifier` - amplifier used to calculate `invariant`
+     * - `{binary_extension<uint64_t>} ramp_start_amplifier` - amplifier when `ramp` was initialized
+     * - `{binary_extension<uint64_t>} ramp_target_amplifier` - target amplifier when `ramp_end_time` is reached
+     * - `{binary_extension<time_point_sec>} ramp_start_time` - start time of the ramp
+     * - `{binary_extension<time_point_sec>} ramp_end_time` - end time of the ramp (epoch or missing when no ramp is active, see `migrate`)
      *
      * ### example
      *
@@ -126,7 +186,13 @@ public:
      *   "volume0": "100.0000 A",
      *   "volume1": "100.0000 B",
      *   "trades": 123,
-     *   "last_updated": "2020-11-23T00:00:00"
+     *   "last_updated": "2020-11-23T00:00:00",
+     *   "invariant": 2000000000,
+     *   "invariant_amplifier": 450,
+     *   "ramp_start_amplifier": 450,
+     *   "ramp_target_amplifier": 200,
+     *   "ramp_start_time": "2021-02-03T00:00:00",
+     *   "ramp_end_time": "2021-02-04T00:00:00"
      * }
      * ```
      */
@@ -143,15 +209,23 @@ public:
         asset               volume1;
         uint64_t            trades;
         time_point_sec      last_updated;
+        binary_extension<uint64_t>  invariant;
+        binary_extension<uint64_t>  invariant_amplifier;
+        binary_extension<uint64_t>          ramp_start_amplifier;
+        binary_extension<uint64_t>          ramp_target_amplifier;
+        binary_extension<time_point_sec>    ramp_start_time;
+        binary_extension<time_point_sec>    ramp_end_time;
 
         uint64_t primary_key() const { return id.raw(); }
     };
-    typedef eosio::multi_index< "pairs"_n, pairs_row> pairs_table;
+    typedef profile::multi_index< "pairs"_n, pairs_row> pairs_table;
 
     /**
      * ## TABLE `ramp`
      *
-     * - `{symbol_code} id` - pair id
+     * Legacy ramp state, ramps are now stored in `pairs` (rows are moved by `migrate`)
+     *
+     * - `{symbol_code} pair_id` - pair id
      * - `{uint64_t} start_amplifier` - start amplifier when `ramp` action is initialized
      * - `{uint64_t} target_amplifier` - target amplifier when end time is reached
      * - `{time_point_sec} start_time` - start time when `ramp` action is initialized
@@ -161,10 +235,10 @@ public:
      *
      * ```json
      * {
-     *   "id": "AB",
+     *   "pair_id": "AB",
      *   "start_amplifier": 100,
      *   "target_amplifier": 200,
-     *   "start_time": "2021-02-03T00:00:00"
+     *   "start_time": "2021-02-03T00:00:00",
      *   "end_time": "2021-02-04T00:00:00"
      * }
      * ```
@@ -178,14 +252,154 @@ public:
 
         uint64_t primary_key() const { return pair_id.raw(); }
     };
-    typedef eosio::multi_index< "ramp"_n, ramp_row> ramp_table;
+    typedef profile::multi_index< "ramp"_n, ramp_row> ramp_table;
+
+    /**
+     * ## TABLE `pools`
+     *
+     * Multi-coin pools (3 or 4 reserves), liquidity token shares its symbol code with `id`
+     *
+     * - `{symbol_code} id` - pool id
+     * - `{vector<extended_asset>} reserves` - reserve assets
+     * - `{extended_asset} liquidity` - liquidity asset
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{double} virtual_price` - reserves normalized to liquidity precision relative to liquidity supply
+     * - `{vector<asset>} volumes` - cumulative incoming trading volume per reserve
+     * - `{uint64_t} trades` - cumulative trades count
+     * - `{time_point_sec} last_updated` - last updated timestamp
+     * - `{uint64_t} invariant` - invariant D of reserves normalized to `MAX_PRECISION`
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "id": "ABC",
+     *   "reserves": [
+     *     {"quantity": "1000.0000 A", "contract": "eosio.token"},
+     *     {"quantity": "1000.0000 B", "contract": "eosio.token"},
+     *     {"quantity": "1000.000000000 C", "contract": "eosio.token"}
+     *   ],
+     *   "liquidity": {"quantity": "3000.000000000 ABC", "contract": "lptoken.sx"},
+     *   "amplifier": 450,
+     *   "virtual_price": 1.0,
+     *   "volumes": ["100.0000 A", "0.0000 B", "0.000000000 C"],
+     *   "trades": 123,
+     *   "last_updated": "2020-11-23T00:00:00",
+     *   "invariant": 3000000000
+     * }
+     * ```
+     */
+    struct [[eosio::table("pools")]] pools_row {
+        symbol_code             id;
+        vector<extended_asset>  reserves;
+        extended_asset          liquidity;
+        uint64_t                amplifier;
+        double                  virtual_price;
+        vector<asset>           volumes;
+        uint64_t                trades;
+        time_point_sec          last_updated;
+        uint64_t                invariant;
+
+        uint64_t primary_key() const { return id.raw(); }
+    };
+    typedef profile::multi_index< "pools"_n, pools_row> pools_table;
+
+    /**
+     * ## TABLE `poolorders`
+     *
+     * *scope*: `pool_id` (symbol_code)
+     *
+     * - `{name} owner` - owner account
+     * - `{vector<extended_asset>} quantities` - deposited quantities (same order as pool reserves)
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "owner": "myaccount",
+     *   "quantities": [
+     *     {"contract": "eosio.token", "quantity": "1000.0000 A"},
+     *     {"contract": "eosio.token", "quantity": "1000.0000 B"},
+     *     {"contract": "eosio.token", "quantity": "0.000000000 C"}
+     *   ]
+     * }
+     * ```
+     */
+    struct [[eosio::table("poolorders")]] poolorders_row {
+        name                    owner;
+        vector<extended_asset>  quantities;
+
+        uint64_t primary_key() const { return owner.value; }
+    };
+    typedef profile::multi_index< "poolorders"_n, poolorders_row> poolorders_table;
+
+    /**
+     * ## TABLE `fees`
+     *
+     * Protocol fees accrued by swaps, paid out to `config.fee_account` by `claimfees`
+     *
+     * *scope*: `contract` (name) - token contract
+     *
+     * - `{extended_asset} balance` - accrued protocol fees
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "balance": {"contract": "eosio.token", "quantity": "0.1000 A"}
+     * }
+     * ```
+     */
+    struct [[eosio::table("fees")]] fees_row {
+        extended_asset      balance;
+
+        uint64_t primary_key() const { return balance.quantity.symbol.code().raw(); }
+    };
+    typedef profile::multi_index< "fees"_n, fees_row> fees_table;
+
+    /**
+     * ## TABLE `routes`
+     *
+     * Swap routes registered by `addroute`, referenced by swap memos as `@<route_id>`
+     *
+     * - `{uint64_t} route_id` - route id
+     * - `{vector<symbol_code>} pair_ids` - pairs of each hop
+     * - `{extended_symbol} in` - input extended symbol
+     * - `{extended_symbol} out` - output extended symbol
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "route_id": 1,
+     *   "pair_ids": ["AB", "BC"],
+     *   "in": {"contract": "eosio.token", "sym": "4,A"},
+     *   "out": {"contract": "eosio.token", "sym": "9,C"}
+     * }
+     * ```
+     */
+    struct [[eosio::table("routes")]] routes_row {
+        uint64_t                route_id;
+        vector<symbol_code>     pair_ids;
+        extended_symbol         in;
+        extended_symbol         out;
+
+        uint64_t primary_key() const { return route_id; }
+    };
+    typedef profile::multi_index< "routes"_n, routes_row> routes_table;
+
+    // memo `pair_ids`, stored inline (no heap allocation while parsing the memo)
+    typedef sx::utils::fixed_vector<symbol_code, MAX_PAIR_IDS> pair_ids_vector;
 
     /**
      * ## STRUCT `memo_schema`
      *
-     * - `{name} action` - action name ("swap", "deposit")
-     * - `{vector<symbol_code>} pair_ids` - symbol codes pair ids
-     * - `{int64_t} min_return` - minimum return amount expected
+     * - `{name} action` - action name ("swap", "swapout", "swappool", "deposit")
+     * - `{pair_ids_vector} pair_ids` - symbol codes pair ids (or single pool id)
+     * - `{int64_t} min_return` - minimum return amount expected (exact output amount for "swapout")
+     * - `{symbol_code} symcode_out` - output symbol code ("swappool" only)
+     * - `{name} recipient` - account receiving the swap output instead of the sender ("swap" & "swapout" only)
+     * - `{string_view} recipient_memo` - transfer memo of the swap output to `recipient`, rest of the memo (may contain commas)
      *
      * ### example
      *
@@ -193,14 +407,76 @@ public:
      * {
      *   "action": "swap",
      *   "pair_ids": ["AB", "BC"],
-     *   "min_return": 100
+     *   "min_return": 100,
+     *   "symcode_out": "",
+     *   "recipient": "myreceiver",
+     *   "recipient_memo": "order 123"
      * }
      * ```
      */
     struct memo_schema {
         name                    action;
-        vector<symbol_code>     pair_ids;
+        pair_ids_vector         pair_ids;
         int64_t                 min_return;
+        symbol_code             symcode_out;
+        name                    recipient;
+        string_view             recipient_memo;
+    };
+
+    /**
+     * ## STRUCT `swap_hop`
+     *
+     * One hop of a multi-hop swap logged by `routelog` (same fields as `swaplog`)
+     *
+     * - `{symbol_code} pair_id` - pair id
+     * - `{asset} quantity_in` - input quantity
+     * - `{asset} quantity_out` - output quantity
+     * - `{asset} fee` - trade & protocol fee
+     * - `{double} trade_price` - trade price
+     * - `{asset} reserve0` - pair reserve0 after the trade
+     * - `{asset} reserve1` - pair reserve1 after the trade
+     *
+     * ### example
+     *
+     * ```json
+     * {
+     *   "pair_id": "AB",
+     *   "quantity_in": "10.0000 A",
+     *   "quantity_out": "9.9950 B",
+     *   "fee": "0.0050 A",
+     *   "trade_price": 0.9995,
+     *   "reserve0": "400010.0000 A",
+     *   "reserve1": "399990.0050 B"
+     * }
+     * ```
+     */
+    struct swap_hop {
+        symbol_code         pair_id;
+        asset               quantity_in;
+        asset               quantity_out;
+        asset               fee;
+        double              trade_price;
+        asset               reserve0;
+        asset               reserve1;
+    };
+
+    /**
+     * ## STRUCT `context`
+     *
+     * Per-action state of `on_transfer`, loaded once & passed down the swap path (`convert` => `apply_trade`)
+     *
+     * - `{config_row} config` - contract config, read once per action
+     * - `{pairs_table} pairs` - pairs table
+     * - `{vector<pairs_table::const_iterator>} route` - pairs of the memo `pair_ids`, found while parsing the memo
+     * - `{extended_symbol} route_in` - input of a registered route (`@<route_id>` memo, hops already chained by `addroute`)
+     * - `{extended_symbol} route_out` - output of a registered route
+     */
+    struct context {
+        config_row                              config;
+        pairs_table                             pairs;
+        vector<pairs_table::const_iterator>     route;
+        extended_symbol                         route_in;
+        extended_symbol                         route_out;
     };
 
     // USER
@@ -226,9 +502,30 @@ public:
     [[eosio::action]]
     void removepair( const symbol_code pair_id );
 
+    [[eosio::action]]
+    void createpool( const name creator, const symbol_code pool_id, const vector<extended_symbol> reserves, const uint64_t amplifier );
+
+    [[eosio::action]]
+    void removepool( const symbol_code pool_id );
+
+    [[eosio::action]]
+    void addroute( const uint64_t route_id, const extended_symbol in, const vector<symbol_code> pair_ids );
+
+    [[eosio::action]]
+    void delroute( const uint64_t route_id );
+
     [[eosio::action]]
     void setnotifiers( const vector<name> notifiers );
 
+    [[eosio::action]]
+    void subscribe( const name notifier, const symbol_code pair_id );
+
+    [[eosio::action]]
+    void unsubscribe( const name notifier, const symbol_code pair_id );
+
+    [[eosio::action]]
+    void setlognotify( const bool notify_logs );
+
     [[eosio::action]]
     void setfee( const uint8_t trade_fee, const optional<uint8_t> protocol_fee, const optional<name> fee_account );
 
@@ -241,29 +538,52 @@ public:
     [[eosio::action]]
     void stopramp( const symbol_code pair_id );
 
+    [[eosio::action]]
+    void migrate();
+
     [[eosio::action]]
     void liquiditylog( const symbol_code pair_id, const name owner, const name action, const asset liquidity, const asset quantity0, const asset quantity1, const asset total_liquidity, const asset reserve0, const asset reserve1 );
 
     [[eosio::action]]
     void swaplog( const symbol_code pair_id, const name owner, const name action, const asset quantity_in, const asset quantity_out, const asset fee, const double trade_price, const asset reserve0, const asset reserve1 );
 
+    [[eosio::action]]
+    void routelog( const name owner, const name action, const vector<swap_hop> hops );
+
+    [[eosio::action]]
+    void claimfees( const name contract );
+
     [[eosio::action]]
     void calculate( const uint64_t amount, const uint64_t reserve_in, const uint64_t reserve_out, const uint64_t amplifier, const uint64_t fee );
 
+    [[eosio::action]]
+    void solverstats( const symbol_code pair_id, const asset quantity_in );
+
     using init_action = eosio::action_wrapper<"init"_n, &sx::curve::init>;
     using reset_action = eosio::action_wrapper<"reset"_n, &sx::curve::reset>;
     using deposit_action = eosio::action_wrapper<"deposit"_n, &sx::curve::deposit>;
     using cancel_action = eosio::action_wrapper<"cancel"_n, &sx::curve::cancel>;
     using createpair_action = eosio::action_wrapper<"createpair"_n, &sx::curve::createpair>;
     using removepair_action = eosio::action_wrapper<"removepair"_n, &sx::curve::removepair>;
+    using createpool_action = eosio::action_wrapper<"createpool"_n, &sx::curve::createpool>;
+    using removepool_action = eosio::action_wrapper<"removepool"_n, &sx::curve::removepool>;
+    using addroute_action = eosio::action_wrapper<"addroute"_n, &sx::curve::addroute>;
+    using delroute_action = eosio::action_wrapper<"delroute"_n, &sx::curve::delroute>;
     using setfee_action = eosio::action_wrapper<"setfee"_n, &sx::curve::setfee>;
     using setnotifiers_action = eosio::action_wrapper<"setnotifiers"_n, &sx::curve::setnotifiers>;
+    using subscribe_action = eosio::action_wrapper<"subscribe"_n, &sx::curve::subscribe>;
+    using unsubscribe_action = eosio::action_wrapper<"unsubscribe"_n, &sx::curve::unsubscribe>;
+    using setlognotify_action = eosio::action_wrapper<"setlognotify"_n, &sx::curve::setlognotify>;
     using setstatus_action = eosio::action_wrapper<"setstatus"_n, &sx::curve::setstatus>;
     using ramp_action = eosio::action_wrapper<"ramp"_n, &sx::curve::ramp>;
     using stopramp_action = eosio::action_wrapper<"stopramp"_n, &sx::curve::stopramp>;
+    using migrate_action = eosio::action_wrapper<"migrate"_n, &sx::curve::migrate>;
     using liquiditylog_action = eosio::action_wrapper<"liquiditylog"_n, &sx::curve::liquiditylog>;
     using swaplog_action = eosio::action_wrapper<"swaplog"_n, &sx::curve::swaplog>;
+    using routelog_action = eosio::action_wrapper<"routelog"_n, &sx::curve::routelog>;
+    using claimfees_action = eosio::action_wrapper<"claimfees"_n, &sx::curve::claimfees>;
     using calculate_action = eosio::action_wrapper<"calculate"_n, &sx::curve::calculate>;
+    using solverstats_action = eosio::action_wrapper<"solverstats"_n, &sx::curve::solverstats>;
 
     /**
      * ## STATIC `get_amplifier`
@@ -288,23 +608,24 @@ public:
      */
     static uint64_t get_amplifier( const symbol_code pair_id, const name code = sx::curve::code )
     {
-        sx::curve::ramp_table _ramp( code, code.value );
         sx::curve::pairs_table _pairs( code, code.value );
+        return get_amplifier( _pairs.get( pair_id.raw(), "curve.sx::get_amplifier: invalid `pair_id`" ) );
+    }
 
-        auto pairs = _pairs.get( pair_id.raw(), "curve.sx::get_amplifier: invalid `pair_id`" );
-        auto ramp = _ramp.find( pair_id.raw() );
-
-        // if no ramp exists, use pair's amplifier
-        if ( ramp == _ramp.end() ) return pairs.amplifier;
+    // current amplifier of an already loaded pair, ramp state is stored inline (no table reads)
+    static uint64_t get_amplifier( const pairs_row& pairs )
+    {
+        // if no ramp is active, use pair's amplifier
+        const uint32_t t1 = get_ramp_end_time( pairs );
+        if ( !t1 ) return pairs.amplifier;
 
         const uint32_t now = current_time_point().sec_since_epoch();
-        const uint32_t t1 = ramp->end_time.sec_since_epoch();
-        const uint64_t A1 = ramp->target_amplifier;
+        const uint64_t A1 = pairs.ramp_target_amplifier.value();
 
         // ramping up or down amplifier
         if ( now < t1 ) {
-            const uint64_t A0 = ramp->start_amplifier;
-            const uint32_t t0 = ramp->start_time.sec_since_epoch();
+            const uint64_t A0 = pairs.ramp_start_amplifier.value();
+            const uint32_t t0 = pairs.ramp_start_time.value().sec_since_epoch();
 
             // ramp down if future amplifier is smaller than initial amplifier
             if ( A1 > A0 ) return A0 + (A1 - A0) * (now - t0) / (t1 - t0);
@@ -314,6 +635,35 @@ public:
         } else return A1;
     }
 
+    // store the current amplifier in the pair row, ramp state is cleared once the ramp has ended (lazy finalization)
+    static void update_amplifier( pairs_row& row )
+    {
+        row.amplifier = get_amplifier( row );
+        const uint32_t end_time = get_ramp_end_time( row );
+        if ( end_time && current_time_point().sec_since_epoch() >= end_time ) clear_ramp( row );
+    }
+
+    // end time of the active ramp (0 when no ramp is active or the row was created before ramps were stored in `pairs`)
+    static uint32_t get_ramp_end_time( const pairs_row& row )
+    {
+        return row.ramp_end_time.value_or( time_point_sec{} ).sec_since_epoch();
+    }
+
+    // ramp fields follow `invariant` in the row layout, which is stored first for rows created before either existed
+    static void set_ramp( pairs_row& row, const uint64_t start_amplifier, const uint64_t target_amplifier, const time_point_sec start_time, const time_point_sec end_time )
+    {
+        if ( !row.invariant.has_value() ) update_invariant( row );
+        row.ramp_start_amplifier.emplace( start_amplifier );
+        row.ramp_target_amplifier.emplace( target_amplifier );
+        row.ramp_start_time.emplace( start_time );
+        row.ramp_end_time.emplace( end_time );
+    }
+
+    static void clear_ramp( pairs_row& row )
+    {
+        set_ramp( row, 0, 0, time_point_sec{}, time_point_sec{} );
+    }
+
     /**
      * ## STATIC `get_amount_out`
      *
@@ -345,12 +695,20 @@ public:
         check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
 
         // get configs
-        auto config = _config.get();
-        auto pairs = _pairs.get( pair_id.raw(), "curve::get_amount_out: invalid pair id" );
+        const auto config = _config.get();
+        const auto& pairs = _pairs.get( pair_id.raw(), "curve::get_amount_out: invalid pair id" );
+
+        return get_amount_out( in, pairs, config, get_amplifier( pairs ) );
+    }
 
+    // `get_amount_out` of an already loaded pair, config & current amplifier (no table reads), optionally filling solver telemetry
+    static asset get_amount_out( const asset in, pairs_row pairs, const config_row& config, const uint64_t amplifier, Curve::solver_result* result = nullptr )
+    {
         // inverse reserves based on input quantity
-        if (pairs.reserve0.quantity.symbol != in.symbol) std::swap(pairs.reserve0, pairs.reserve1);
+        const bool is_reversed = pairs.reserve0.quantity.symbol != in.symbol;
+        if (is_reversed) std::swap(pairs.reserve0, pairs.reserve1);
         eosio::check( pairs.reserve0.quantity.symbol == in.symbol, "curve::get_amount_out: no such reserve in pairs");
+        const uint64_t invariant = get_stored_invariant( pairs, amplifier, is_reversed, result );
 
         // normalize inputs to max precision
         const uint8_t precision_in = pairs.reserve0.quantity.symbol.precision();
@@ -358,18 +716,344 @@ public:
         const int64_t amount_in = mul_amount( in.amount, MAX_PRECISION, precision_in );
         const int64_t reserve_in = mul_amount( pairs.reserve0.quantity.amount, MAX_PRECISION, precision_in );
         const int64_t reserve_out = mul_amount( pairs.reserve1.quantity.amount, MAX_PRECISION, precision_out );
-        const uint64_t amplifier = get_amplifier( pair_id, code );
         const int64_t protocol_fee = amount_in * config.protocol_fee / 10000;
 
         // enforce minimum fee
         if ( config.trade_fee ) check( in.amount * config.trade_fee / 10000, "curve::get_amount_out: trade quantity too small");
 
         // calculate out
-        const int64_t out = div_amount( static_cast<int64_t>(Curve::get_amount_out( amount_in - protocol_fee, reserve_in, reserve_out, amplifier, config.trade_fee )), MAX_PRECISION, precision_out );
+        const int64_t out = div_amount( static_cast<int64_t>(Curve::get_amount_out( amount_in - protocol_fee, reserve_in, reserve_out, amplifier, config.trade_fee, invariant, result )), MAX_PRECISION, precision_out );
 
         return { out, pairs.reserve1.quantity.symbol };
     }
 
+    /**
+     * ## STATIC `get_amount_in`
+     *
+     * Calculate input required to receive at least {out} amount via {pair_id} pool
+     *
+     * ### params
+     *
+     * - `{asset} out` - output token quantity
+     * - `{symbol_code} pair_id` - pair id
+     *
+     * ### returns
+     *
+     * - `{asset}` - calculated input
+     *
+     * ### example
+     *
+     * ```c++
+     * const asset out = asset{10'1000, {"B", 4}};
+     * const symbol_code pair_id = symbol_code{"SXA"};
+     *
+     * const asset in = sx::curve::get_amount_in( out, pair_id );
+     * //=> "10.0000 A"
+     * ```
+     */
+    static asset get_amount_in( const asset out, const symbol_code pair_id, const name code = sx::curve::code )
+    {
+        sx::curve::config_table _config( code, code.value );
+        sx::curve::pairs_table _pairs( code, code.value );
+        check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
+
+        // get configs
+        const auto config = _config.get();
+        const auto& pairs = _pairs.get( pair_id.raw(), "curve::get_amount_in: invalid pair id" );
+
+        return get_amount_in( out, pairs, config, get_amplifier( pairs ) );
+    }
+
+    // `get_amount_in` of an already loaded pair, config & current amplifier (no table reads)
+    static asset get_amount_in( const asset out, pairs_row pairs, const config_row& config, const uint64_t amplifier )
+    {
+        // inverse reserves based on output quantity
+        const bool is_reversed = pairs.reserve1.quantity.symbol != out.symbol;
+        if (is_reversed) std::swap(pairs.reserve0, pairs.reserve1);
+        eosio::check( pairs.reserve1.quantity.symbol == out.symbol, "curve::get_amount_in: no such reserve in pairs");
+        const uint64_t invariant = get_stored_invariant( pairs, amplifier, is_reversed );
+
+        // normalize to max precision, rounding required output up
+        const uint8_t precision_in = pairs.reserve0.quantity.symbol.precision();
+        const uint8_t precision_out = pairs.reserve1.quantity.symbol.precision();
+        int64_t amount_out = mul_amount( out.amount, MAX_PRECISION, precision_out );
+        if ( div_amount( amount_out, MAX_PRECISION, precision_out ) < out.amount ) amount_out++;
+        const int64_t reserve_in = mul_amount( pairs.reserve0.quantity.amount, MAX_PRECISION, precision_in );
+        const int64_t reserve_out = mul_amount( pairs.reserve1.quantity.amount, MAX_PRECISION, precision_out );
+
+        // calculate in, then add back protocol fee
+        const int64_t net_in = Curve::get_amount_in( amount_out, reserve_in, reserve_out, amplifier, config.trade_fee, invariant );
+        check( net_in >= 0, "curve::get_amount_in: invalid input amount");
+        const uint128_t net = static_cast<uint128_t>( net_in );
+        int64_t amount_in = (net * 10000 + 9999 - config.protocol_fee) / (10000 - config.protocol_fee);
+        while ( amount_in > net_in && (amount_in - 1) - static_cast<uint128_t>( amount_in - 1 ) * config.protocol_fee / 10000 >= net ) amount_in--;
+
+        // denormalize, rounding input up
+        int64_t in = div_amount( amount_in, MAX_PRECISION, precision_in );
+        if ( mul_amount( in, MAX_PRECISION, precision_in ) < amount_in ) in++;
+
+        // enforce minimum fee
+        if ( config.trade_fee ) check( in * config.trade_fee / 10000, "curve::get_amount_in: trade quantity too small");
+
+        return { in, pairs.reserve0.quantity.symbol };
+    }
+
+    /**
+     * ## STATIC `get_amounts_out`
+     *
+     * Calculate returns for converting each of {ins} amounts via {pair_id} pool
+     * Configs, pair & amplifier are loaded once and invariant D is shared by all quotes
+     *
+     * ### params
+     *
+     * - `{vector<asset>} ins` - input token quantities (same symbol)
+     * - `{symbol_code} pair_id` - pair id
+     *
+     * ### returns
+     *
+     * - `{vector<asset>}` - calculated returns (same order as `ins`)
+     *
+     * ### example
+     *
+     * ```c++
+     * const vector<asset> ins = { asset{10'0000, {"A", 4}}, asset{100'0000, {"A", 4}} };
+     * const symbol_code pair_id = symbol_code{"SXA"};
+     *
+     * const vector<asset> outs = sx::curve::get_amounts_out( ins, pair_id );
+     * //=> [ "10.1000 B", "100.9900 B" ]
+     * ```
+     */
+    static vector<asset> get_amounts_out( const vector<asset>& ins, const symbol_code pair_id, const name code = sx::curve::code )
+    {
+        sx::curve::config_table _config( code, code.value );
+        sx::curve::pairs_table _pairs( code, code.value );
+        check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
+        check( ins.size(), "curve::get_amounts_out: empty input quantities" );
+
+        // get configs
+        auto config = _config.get();
+        auto pairs = _pairs.get( pair_id.raw(), "curve::get_amounts_out: invalid pair id" );
+
+        const uint64_t amplifier = get_amplifier( pairs );
+
+        // inverse reserves based on input quantity
+        const symbol sym_in = ins[0].symbol;
+        const bool is_reversed = pairs.reserve0.quantity.symbol != sym_in;
+        if (is_reversed) std::swap(pairs.reserve0, pairs.reserve1);
+        eosio::check( pairs.reserve0.quantity.symbol == sym_in, "curve::get_amounts_out: no such reserve in pairs");
+        const uint64_t invariant = get_stored_invariant( pairs, amplifier, is_reversed );
+
+        // normalize reserves to max precision
+        const uint8_t precision_in = pairs.reserve0.quantity.symbol.precision();
+        const uint8_t precision_out = pairs.reserve1.quantity.symbol.precision();
+        const int64_t reserve_in = mul_amount( pairs.reserve0.quantity.amount, MAX_PRECISION, precision_in );
+        const int64_t reserve_out = mul_amount( pairs.reserve1.quantity.amount, MAX_PRECISION, precision_out );
+
+        vector<asset> outs;
+        outs.reserve( ins.size() );
+        for ( const asset& in : ins ) {
+            eosio::check( in.symbol == sym_in, "curve::get_amounts_out: input quantities must share the same symbol");
+            const int64_t amount_in = mul_amount( in.amount, MAX_PRECISION, precision_in );
+            const int64_t protocol_fee = amount_in * config.protocol_fee / 10000;
+
+            // enforce minimum fee
+            if ( config.trade_fee ) check( in.amount * config.trade_fee / 10000, "curve::get_amounts_out: trade quantity too small");
+
+            // calculate out
+            const int64_t out = div_amount( static_cast<int64_t>(Curve::get_amount_out( amount_in - protocol_fee, reserve_in, reserve_out, amplifier, config.trade_fee, invariant )), MAX_PRECISION, precision_out );
+            outs.push_back({ out, pairs.reserve1.quantity.symbol });
+        }
+        return outs;
+    }
+
+    /**
+     * ## STATIC `get_invariant`
+     *
+     * Calculate invariant D of pair reserves normalized to `MAX_PRECISION`
+     *
+     * ### params
+     *
+     * - `{pairs_row} pair` - pair
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{Curve::solver_result*} [result=nullptr]` - optional solver telemetry
+     *
+     * ### returns
+     *
+     * - `{uint64_t}` - invariant D (0 if reserves are empty)
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint64_t invariant = sx::curve::get_invariant( pair, 450 );
+     * //=> 2000000000
+     * ```
+     */
+    static uint64_t get_invariant( const pairs_row& pair, const uint64_t amplifier, Curve::solver_result* result = nullptr )
+    {
+        const int64_t reserve0 = mul_amount( pair.reserve0.quantity.amount, MAX_PRECISION, pair.reserve0.quantity.symbol.precision() );
+        const int64_t reserve1 = mul_amount( pair.reserve1.quantity.amount, MAX_PRECISION, pair.reserve1.quantity.symbol.precision() );
+        if ( !reserve0 || !reserve1 ) return 0;
+
+        return Curve::get_invariant( reserve0, reserve1, amplifier, result );
+    }
+
+    // stored invariant D, recalculated when missing (rows created before it was stored) or the amplifier has been ramped since last update
+    // `pair` reserves are in input/output order: D floors `prod1` in that order, so the stored D (`reserve0`/`reserve1` order)
+    // only serves swaps from `reserve0`, swaps from `reserve1` (`is_reversed`) solve it again to keep quotes bit-identical
+    static uint64_t get_stored_invariant( const pairs_row& pair, const uint64_t amplifier, const bool is_reversed, Curve::solver_result* result = nullptr )
+    {
+        const uint64_t invariant = pair.invariant.value_or( 0 );
+        if ( !is_reversed && invariant && pair.invariant_amplifier.value_or( 0 ) == amplifier ) return invariant;
+        return get_invariant( pair, amplifier, result );
+    }
+
+    // store invariant D at the stored amplifier, also fills the `binary_extension` fields of rows created before they existed
+    static void update_invariant( pairs_row& row )
+    {
+        row.invariant.emplace( get_invariant( row, row.amplifier ) );
+        row.invariant_amplifier.emplace( row.amplifier );
+    }
+
+    /**
+     * ## STATIC `get_pool_amount_out`
+     *
+     * Calculate return for converting {in} amount to {symcode_out} via {pool_id} multi-coin pool
+     *
+     * ### params
+     *
+     * - `{asset} in` - input token quantity
+     * - `{symbol_code} pool_id` - pool id
+     * - `{symbol_code} symcode_out` - output symbol code
+     *
+     * ### returns
+     *
+     * - `{asset}` - calculated return
+     *
+     * ### example
+     *
+     * ```c++
+     * const asset in = asset{10'0000, {"A", 4}};
+     * const symbol_code pool_id = symbol_code{"ABC"};
+     *
+     * const asset out = sx::curve::get_pool_amount_out( in, pool_id, symbol_code{"C"} );
+     * //=> "10.000000000 C"
+     * ```
+     */
+    static asset get_pool_amount_out( const asset in, const symbol_code pool_id, const symbol_code symcode_out, const name code = sx::curve::code )
+    {
+        sx::curve::config_table _config( code, code.value );
+        sx::curve::pools_table _pools( code, code.value );
+        check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
+
+        // get configs
+        const auto config = _config.get();
+        const auto& pool = _pools.get( pool_id.raw(), "curve::get_pool_amount_out: invalid pool id" );
+
+        return get_pool_amount_out( in, pool, config, symcode_out );
+    }
+
+    // `get_pool_amount_out` of an already loaded pool & config (no table reads)
+    static asset get_pool_amount_out( const asset in, const pools_row& pool, const config_row& config, const symbol_code symcode_out )
+    {
+        // find reserves
+        const uint8_t index_in = get_pool_index( pool, in.symbol.code() );
+        const uint8_t index_out = get_pool_index( pool, symcode_out );
+        eosio::check( pool.reserves[index_in].quantity.symbol == in.symbol, "curve::get_pool_amount_out: invalid input symbol");
+
+        // normalize inputs to max precision
+        const uint8_t precision_in = pool.reserves[index_in].quantity.symbol.precision();
+        const uint8_t precision_out = pool.reserves[index_out].quantity.symbol.precision();
+        const int64_t amount_in = mul_amount( in.amount, MAX_PRECISION, precision_in );
+        const int64_t protocol_fee = amount_in * config.protocol_fee / 10000;
+        const vector<uint64_t> reserves = get_pool_reserves( pool );
+        const uint64_t invariant = pool.invariant ? pool.invariant : get_pool_invariant( reserves, pool.amplifier );
+
+        // enforce minimum fee
+        if ( config.trade_fee ) check( in.amount * config.trade_fee / 10000, "curve::get_pool_amount_out: trade quantity too small");
+
+        // calculate out
+        const int64_t out = div_amount( static_cast<int64_t>(get_pool_amount_out( amount_in - protocol_fee, reserves, index_in, index_out, pool.amplifier, config.trade_fee, invariant )), MAX_PRECISION, precision_out );
+
+        return { out, pool.reserves[index_out].quantity.symbol };
+    }
+
+    /**
+     * ## STATIC `get_pool_amount_out`
+     *
+     * Dispatch normalized pool reserves to `Curve::get_amount_out<N>`
+     *
+     * ### params
+     *
+     * - `{uint64_t} amount_in` - amount input
+     * - `{vector<uint64_t>} reserves` - reserves normalized to `MAX_PRECISION`
+     * - `{uint8_t} index_in` - index of input reserve
+     * - `{uint8_t} index_out` - index of output reserve
+     * - `{uint64_t} amplifier` - amplifier
+     * - `{uint8_t} fee` - trade fee (pips 1/100 of 1%)
+     * - `{uint64_t} invariant` - invariant D
+     *
+     * ### returns
+     *
+     * - `{uint64_t}` - amount output
+     */
+    static uint64_t get_pool_amount_out( const uint64_t amount_in, const vector<uint64_t>& reserves, const uint8_t index_in, const uint8_t index_out, const uint64_t amplifier, const uint8_t fee, const uint64_t invariant )
+    {
+        switch ( reserves.size() ) {
+            case 3: return Curve::get_amount_out<3>( amount_in, { reserves[0], reserves[1], reserves[2] }, index_in, index_out, amplifier, fee, invariant );
+            case 4: return Curve::get_amount_out<4>( amount_in, { reserves[0], reserves[1], reserves[2], reserves[3] }, index_in, index_out, amplifier, fee, invariant );
+        }
+        check( false, "curve::get_pool_amount_out: unsupported number of reserves" );
+        return 0;
+    }
+
+    /**
+     * ## STATIC `get_pool_invariant`
+     *
+     * Dispatch normalized pool reserves to `Curve::get_invariant<N>`
+     *
+     * ### params
+     *
+     * - `{vector<uint64_t>} reserves` - reserves normalized to `MAX_PRECISION`
+     * - `{uint64_t} amplifier` - amplifier
+     *
+     * ### returns
+     *
+     * - `{uint64_t}` - invariant D (0 if any reserve is empty)
+     */
+    static uint64_t get_pool_invariant( const vector<uint64_t>& reserves, const uint64_t amplifier )
+    {
+        for ( const uint64_t reserve : reserves ) {
+            if ( !reserve ) return 0;
+        }
+        switch ( reserves.size() ) {
+            case 3: return Curve::get_invariant<3>( { reserves[0], reserves[1], reserves[2] }, amplifier );
+            case 4: return Curve::get_invariant<4>( { reserves[0], reserves[1], reserves[2], reserves[3] }, amplifier );
+        }
+        check( false, "curve::get_pool_invariant: unsupported number of reserves" );
+        return 0;
+    }
+
+    // pool reserves normalized to `MAX_PRECISION`
+    static vector<uint64_t> get_pool_reserves( const pools_row& pool )
+    {
+        vector<uint64_t> reserves;
+        reserves.reserve( pool.reserves.size() );
+        for ( const extended_asset& reserve : pool.reserves ) {
+            reserves.push_back( mul_amount( reserve.quantity.amount, MAX_PRECISION, reserve.quantity.symbol.precision() ) );
+        }
+        return reserves;
+    }
+
+    // index of pool reserve by symbol code
+    static uint8_t get_pool_index( const pools_row& pool, const symbol_code symcode )
+    {
+        for ( uint8_t i = 0; i < pool.reserves.size(); i++ ) {
+            if ( pool.reserves[i].quantity.symbol.code() == symcode ) return i;
+        }
+        check( false, "curve::get_pool_index: no such reserve in pool" );
+        return 0;
+    }
+
     static pair<asset, asset> get_reserves( const symbol_code pair_id, const symbol sort, const name code = sx::curve::code )
     {
         sx::curve::pairs_table _pairs( code, code.value );
@@ -382,16 +1066,88 @@ public:
         return { pairs.reserve0.quantity, pairs.reserve1.quantity };
     }
 
+    // rescale `amount` from `precision1` to `precision0` decimals (integer powers of ten, no floating point)
     static int64_t mul_amount( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
     {
-        const int64_t res = static_cast<int64_t>( precision0 >= precision1 ? safemath::mul(amount, pow(10, precision0 - precision1 )) : amount / static_cast<int64_t>(pow( 10, precision1 - precision0 )));
-        check(res >= 0, "curve::mul_amount: mul/div overflow");
-        return res;
+        CURVE_PROFILE_COUNT( scale, 1 );
+        check(amount >= 0, "curve::mul_amount: mul/div overflow");
+        if ( precision0 == precision1 ) return amount;
+        if ( precision0 < precision1 ) return amount / safemath::pow10( precision1 - precision0 );
+
+        const int64_t factor = safemath::pow10( precision0 - precision1 );
+        check(amount <= INT64_MAX / factor, "curve::mul_amount: mul/div overflow");
+        return amount * factor;
     }
 
+    // rescale `amount` from `precision0` back to `precision1` decimals
     static int64_t div_amount( const int64_t amount, const uint8_t precision0, const uint8_t precision1 )
     {
-        return precision0 >= precision1 ? amount / static_cast<int64_t>(pow( 10, precision0 - precision1 )) : safemath::mul(amount, pow( 10, precision1 - precision0 ));
+        CURVE_PROFILE_COUNT( scale, 1 );
+        if ( precision0 == precision1 ) return amount;
+        if ( precision0 > precision1 ) return amount / safemath::pow10( precision0 - precision1 );
+
+        const int64_t factor = safemath::pow10( precision1 - precision0 );
+        check(amount <= INT64_MAX / factor && amount >= INT64_MIN / factor, "curve::div_amount: mul overflow");
+        return amount * factor;
+    }
+
+    /**
+     * ## STATIC `get_deposit_amounts`
+     *
+     * Amounts accepted from a pending deposit order so the reserves ratio remains the same, the excess is refunded
+     * All values normalized to the same precision, empty reserves fallback to 1
+     *
+     * ### params
+     *
+     * - `{int128_t} amount0` - order amount of reserve0
+     * - `{int128_t} amount1` - order amount of reserve1
+     * - `{int128_t} reserve0` - reserve0
+     * - `{int128_t} reserve1` - reserve1
+     *
+     * ### example
+     *
+     * ```c++
+     * const auto [ deposit0, deposit1 ] = sx::curve::get_deposit_amounts( 100, 300, 1000, 2000 );
+     * //=> { 100, 200 }
+     * ```
+     */
+    static pair<int128_t, int128_t> get_deposit_amounts( const int128_t amount0, const int128_t amount1, const int128_t reserve0, const int128_t reserve1 )
+    {
+        const int128_t reserves = reserve0 + reserve1;
+        const int128_t payment = amount0 + amount1;
+
+        if ( amount0 * reserves <= reserve0 * payment ) return { amount0, amount0 * reserve1 / reserve0 };
+        return { amount1 * reserve0 / reserve1, amount1 };
+    }
+
+    /**
+     * ## STATIC `get_withdraw_amounts`
+     *
+     * Reserve amounts paid out for `retire_amount` (`rex::retire` of the liquidity), split by the reserves ratio
+     * All values normalized to the same precision, the final withdrawal empties both reserves
+     *
+     * ### params
+     *
+     * - `{int64_t} retire_amount` - retired reserves amount
+     * - `{int128_t} reserve0` - reserve0
+     * - `{int128_t} reserve1` - reserve1
+     *
+     * ### example
+     *
+     * ```c++
+     * const auto [ amount0, amount1 ] = sx::curve::get_withdraw_amounts( 300, 1000, 2000 );
+     * //=> { 100, 200 }
+     * ```
+     */
+    static pair<int64_t, int64_t> get_withdraw_amounts( const int64_t retire_amount, const int128_t reserve0, const int128_t reserve1 )
+    {
+        const int128_t reserves = reserve0 + reserve1;
+        const int64_t amount0 = static_cast<int64_t>( retire_amount * reserve0 / reserves );
+        const int64_t amount1 = static_cast<int64_t>( retire_amount * reserve1 / reserves );
+
+        // deal with rounding error on final withdrawal
+        if ( amount0 == reserve0 || amount1 == reserve1 ) return { static_cast<int64_t>( reserve0 ), static_cast<int64_t>( reserve1 ) };
+        return { amount0, amount1 };
     }
 
 private:
@@ -402,19 +1158,35 @@ private:
     void issue( const extended_asset value, const string memo );
 
     // swap conversions
-    void convert( const name owner, const extended_asset ext_in, const vector<symbol_code> pair_ids, const int64_t min_return );
-    extended_asset apply_trade( const name owner, const extended_asset ext_quantity, const vector<symbol_code> pair_ids );
+    void convert( context& ctx, const name owner, const extended_asset ext_in, const int64_t min_return, const name recipient, const string_view recipient_memo );
+    void swap_exact_out( context& ctx, const name owner, const extended_asset ext_in, const int64_t amount_out, const name recipient, const string_view recipient_memo );
+    void transfer_out( const name owner, const name recipient, const string_view recipient_memo, const extended_asset out );
+    extended_asset apply_trade( context& ctx, const name owner, const extended_asset ext_quantity );
+
+    // protocol fees
+    void accrue_fee( const extended_asset fee );
 
     // add/remove liquidity
     void add_liquidity( const name owner, const symbol_code pair_id, const extended_asset value );
     void withdraw_liquidity( const name owner, const extended_asset value );
 
+    // multi-coin pools
+    void swap_pool( const config_row& config, const name owner, const extended_asset ext_in, const symbol_code pool_id, const symbol_code symcode_out, const int64_t min_return );
+    void add_pool_liquidity( const name owner, const symbol_code pool_id, const extended_asset value );
+    void deposit_pool( const name owner, const symbol_code pool_id, const optional<int64_t> min_amount );
+    void cancel_pool( const name owner, const symbol_code pool_id );
+    void withdraw_pool_liquidity( const name owner, const extended_asset value );
+    double calculate_pool_virtual_price( const vector<extended_asset>& reserves, const asset supply );
+
     // utils
-    memo_schema parse_memo( const string memo );
-    vector<symbol_code> parse_memo_pair_ids( const string memo );
+    memo_schema parse_memo( context& ctx, const string_view memo );
+    pair_ids_vector parse_memo_pair_ids( context& ctx, const string_view memo );
+    pair_ids_vector parse_memo_route( context& ctx, const string_view memo );
     double calculate_price( const asset value0, const asset value1 );
     double calculate_virtual_price( const asset value0, const asset value1, const asset supply );
-    void notify();
+    void notify( const vector<name>& notifiers, const pair_ids_vector& pair_ids );
+    void notify_logs( const pair_ids_vector& pair_ids, const bool is_transfer );
+    void set_notifiers( const vector<name> notifiers );
 };
 
 } // namespace sx
@@ -80,4 +80,166 @@ namespace safemath {
         eosio::check(y > 0, "safemath-divide-zero");
         return x / y;
     }
+
+    /**
+     * ## STRUCT `uint256_t`
+     *
+     * Unsigned 256-bit intermediate, only used for products of two 128-bit values
+     *
+     * - `{uint128_t} hi` - high 128 bits
+     * - `{uint128_t} lo` - low 128 bits
+     */
+    struct uint256_t {
+        uint128_t hi;
+        uint128_t lo;
+
+        bool operator<( const uint256_t& y ) const { return hi < y.hi || (hi == y.hi && lo < y.lo); }
+        bool operator>( const uint256_t& y ) const { return y < *this; }
+    };
+
+    /**
+     * ## STATIC `mul256`
+     *
+     * Full 256-bit product of two 128-bit values
+     *
+     * ### params
+     *
+     * - `{uint128_t} x`
+     * - `{uint128_t} y`
+     *
+     * ### example
+     *
+     * ```c++
+     * const safemath::uint256_t z = safemath::mul256(uint128_t(1) << 100, uint128_t(1) << 100);
+     * //=> { hi: 1 << 72, lo: 0 }
+     * ```
+     */
+    static uint256_t mul256(const uint128_t x, const uint128_t y) {
+        const uint128_t mask = ~uint64_t(0);
+        const uint128_t x0 = x & mask, x1 = x >> 64;
+        const uint128_t y0 = y & mask, y1 = y >> 64;
+        const uint128_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+        const uint128_t mid = (p00 >> 64) + (p01 & mask) + (p10 & mask);
+        return { p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64), (mid << 64) | (p00 & mask) };
+    }
+
+    /**
+     * ## STATIC `add256`
+     *
+     * ### params
+     *
+     * - `{uint256_t} x`
+     * - `{uint256_t} y`
+     *
+     * ### example
+     *
+     * ```c++
+     * const safemath::uint256_t z = safemath::add256({0, ~uint128_t(0)}, {0, 1});
+     * //=> { hi: 1, lo: 0 }
+     * ```
+     */
+    static uint256_t add256(const uint256_t x, const uint256_t y) {
+        const uint128_t lo = x.lo + y.lo;
+        const uint128_t hi = x.hi + y.hi + (lo < x.lo);
+        eosio::check(hi > x.hi || (hi == x.hi && lo >= x.lo), "safemath-add-overflow");
+        return { hi, lo };
+    }
+
+    /**
+     * ## STATIC `div256`
+     *
+     * Floor division of a 256-bit value by a 128-bit divisor
+     * 64-bit divisors use limb division, wider divisors fall back to shift-subtract on the low half
+     *
+     * ### params
+     *
+     * - `{uint256_t} x`
+     * - `{uint128_t} y`
+     *
+     * ### example
+     *
+     * ```c++
+     * const safemath::uint256_t z = safemath::div256({1, 0}, 2);
+     * //=> { hi: 0, lo: 1 << 127 }
+     * ```
+     */
+    static uint256_t div256(const uint256_t x, const uint128_t y) {
+        eosio::check(y > 0, "safemath-divide-zero");
+        if ( x.hi == 0 ) return { 0, x.lo / y };
+
+        const uint128_t mask = ~uint64_t(0);
+        if ( y <= mask ) {
+            const uint64_t limbs[4] = { uint64_t(x.hi >> 64), uint64_t(x.hi), uint64_t(x.lo >> 64), uint64_t(x.lo) };
+            uint64_t q[4];
+            uint128_t r = 0;
+            for ( int i = 0; i < 4; i++ ) {
+                const uint128_t cur = (r << 64) | limbs[i];
+                q[i] = cur / y;
+                r = cur % y;
+            }
+            return { (uint128_t(q[0]) << 64) | q[1], (uint128_t(q[2]) << 64) | q[3] };
+        }
+        uint128_t q = 0, r = x.hi % y;
+        for ( int i = 127; i >= 0; i-- ) {
+            const bool carry = r >> 127;
+            r = (r << 1) | ((x.lo >> i) & 1);
+            q <<= 1;
+            if ( carry || r >= y ) { r -= y; q |= 1; }
+        }
+        return { x.hi / y, q };
+    }
+
+    /**
+     * ## STATIC `muldiv`
+     *
+     * `x * y / z` with a 256-bit intermediate product, result must fit in 128 bits
+     *
+     * ### params
+     *
+     * - `{uint128_t} x`
+     * - `{uint128_t} y`
+     * - `{uint128_t} z`
+     *
+     * ### example
+     *
+     * ```c++
+     * const uint128_t z = safemath::muldiv(uint128_t(1) << 100, uint128_t(1) << 100, uint128_t(1) << 90);
+     * //=> 1 << 110
+     * ```
+     */
+    static uint128_t muldiv(const uint128_t x, const uint128_t y, const uint128_t z) {
+        const uint256_t q = div256(mul256(x, y), z);
+        eosio::check(q.hi == 0, "safemath-muldiv-overflow");
+        return q.lo;
+    }
+
+    // powers of ten representable as int64 (asset precision is at most 18)
+    static constexpr uint8_t MAX_POW10 = 18;
+    static constexpr int64_t POW10[MAX_POW10 + 1] = {
+        1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL,
+        1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL,
+        100000000000000LL, 1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+        1000000000000000000LL
+    };
+
+    /**
+     * ## STATIC `pow10`
+     *
+     * Integer power of ten from a constant table (no floating point `pow`)
+     *
+     * ### params
+     *
+     * - `{uint8_t} exponent` - exponent (0-18)
+     *
+     * ### example
+     *
+     * ```c++
+     * const int64_t z = safemath::pow10(4);
+     * //=> 10000
+     * ```
+     */
+    static int64_t pow10(const uint8_t exponent) {
+        eosio::check(exponent <= MAX_POW10, "safemath-pow10-overflow");
+        return POW10[exponent];
+    }
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <eosio/asset.hpp>
-#include <math.h>
+#include <sx.safemath/safemath.hpp>
+
+#include <array>
+#include <initializer_list>
+#include <string_view>
 
 namespace sx {
 namespace utils {
@@ -14,8 +18,51 @@ namespace utils {
     using eosio::symbol_code;
 
     using std::string;
+    using std::string_view;
     using std::vector;
 
+    /**
+     * ## CLASS `fixed_vector`
+     *
+     * Vector with fixed capacity {N} stored inline (no heap allocation), elements must be default constructible
+     *
+     * ### example
+     *
+     * ```c++
+     * sx::utils::fixed_vector<symbol_code, 4> symcodes = { symbol_code{"AB"} };
+     * symcodes.push_back( symbol_code{"BC"} );
+     * // symcodes.size() => 2
+     * ```
+     */
+    template <typename T, size_t N>
+    class fixed_vector {
+    public:
+        fixed_vector() = default;
+        fixed_vector( std::initializer_list<T> values )
+        {
+            for ( const T& value : values ) push_back( value );
+        }
+
+        void push_back( const T& value )
+        {
+            eosio::check( _size < N, "SX.Utils: FIXED_VECTOR_CAPACITY" );
+            _values[ _size++ ] = value;
+        }
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        static constexpr size_t capacity() { return N; }
+
+        const T& operator[]( const size_t index ) const { return _values[ index ]; }
+        const T& back() const { return _values[ _size - 1 ]; }
+        const T* begin() const { return _values.data(); }
+        const T* end() const { return _values.data() + _size; }
+
+    private:
+        std::array<T, N> _values{};
+        size_t _size = 0;
+    };
+
     /**
      * ## STATIC `asset_to_double`
      *
@@ -40,7 +87,7 @@ namespace utils {
     static double asset_to_double( const asset quantity )
     {
         if ( quantity.amount == 0 ) return 0.0;
-        return quantity.amount / pow(10, quantity.symbol.precision());
+        return quantity.amount / static_cast<double>( safemath::pow10( quantity.symbol.precision() ));
     }
 
     /**
@@ -68,7 +115,7 @@ namespace utils {
      */
     static asset double_to_asset( const double amount, const symbol sym )
     {
-        return asset{ static_cast<int64_t>( amount * pow(10, sym.precision())), sym };
+        return asset{ static_cast<int64_t>( amount * safemath::pow10( sym.precision() )), sym };
     }
 
     /**
@@ -144,6 +191,73 @@ namespace utils {
         return tokens;
     }
 
+    /**
+     * ## STATIC `next_token`
+     *
+     * Consume the next non-empty token of {str} (same tokens as `split`, without copies or allocations)
+     *
+     * ### params
+     *
+     * - `{string_view} str` - remaining string, advanced past the returned token
+     * - `{char} delim` - delimiter (ex: ',')
+     *
+     * ### returns
+     *
+     * - `{string_view}` - token (empty once {str} is exhausted)
+     *
+     * ### example
+     *
+     * ```c++
+     * string_view memo = "foo,bar";
+     * const string_view token0 = sx::utils::next_token( memo, ',' );
+     * const string_view token1 = sx::utils::next_token( memo, ',' );
+     * // token0 => "foo"
+     * // token1 => "bar"
+     * ```
+     */
+    static string_view next_token( string_view& str, const char delim )
+    {
+        while ( !str.empty() ) {
+            const size_t pos = str.find( delim );
+            const string_view token = str.substr( 0, pos );
+            str = pos == string_view::npos ? string_view{} : str.substr( pos + 1 );
+            if ( !token.empty() ) return token;
+        }
+        return {};
+    }
+
+    /**
+     * ## STATIC `parse_digits`
+     *
+     * Parse non-negative integer of digits only. Return -1 if empty, not digits or beyond `int64_t`.
+     *
+     * ### params
+     *
+     * - `{string_view} str` - string to parse
+     *
+     * ### returns
+     *
+     * - `{int64_t}` - value or -1
+     *
+     * ### example
+     *
+     * ```c++
+     * const int64_t amount = sx::utils::parse_digits( "10000" );
+     * // amount => 10000
+     * ```
+     */
+    static int64_t parse_digits( const string_view str )
+    {
+        if ( str.empty() ) return -1;
+        int64_t value = 0;
+        for ( const char c : str ) {
+            if ( c < '0' || c > '9' ) return -1;
+            if ( value > ( INT64_MAX - ( c - '0' ) ) / 10 ) return -1;
+            value = value * 10 + ( c - '0' );
+        }
+        return value;
+    }
+
     /**
      * ## STATIC `parse_name`
      *
@@ -151,7 +265,7 @@ namespace utils {
      *
      * ### params
      *
-     * - `{string} str` - string to parse
+     * - `{string_view} str` - string to parse
      *
      * ### returns
      *
@@ -164,7 +278,7 @@ namespace utils {
      * // contract => "tethertether"_n
      * ```
      */
-    static name parse_name(const string& str) {
+    static name parse_name(const string_view str) {
 
         if(str.length()==0 || str.length()>13) return {};
         int i=-1;
@@ -185,7 +299,7 @@ namespace utils {
      *
      * ### params
      *
-     * - `{string} str` - string to parse
+     * - `{string_view} str` - string to parse
      *
      * ### returns
      *
@@ -198,7 +312,7 @@ namespace utils {
      * // symcode => symbol_code{"USDT"}
      * ```
      */
-    static symbol_code parse_symbol_code(const string& str) {
+    static symbol_code parse_symbol_code(const string_view str) {
         if(str.size() > 7) return {};
 
         for (const auto c: str ) {
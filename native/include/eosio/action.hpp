@@ -0,0 +1,107 @@
+#pragma once
+
+#include "native/runtime.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace eosio {
+
+   inline bool has_auth( name n ) {
+      for ( const auto& auth : native::context().act->authorization ) {
+         if ( auth.actor == n ) return true;
+      }
+      return false;
+   }
+
+   inline void require_auth( name n ) {
+      check( has_auth( n ), "missing authority of " + n.to_string() );
+   }
+
+   inline void require_auth( const permission_level& level ) {
+      for ( const auto& auth : native::context().act->authorization ) {
+         if ( auth == level ) return;
+      }
+      check( false, "missing authority of " + level.actor.to_string() + "@" + level.permission.to_string() );
+   }
+
+   inline void require_recipient( name notify_account ) {
+      auto& ctx = native::context();
+      for ( const auto& n : *ctx.notified ) {
+         if ( n == notify_account ) return;
+      }
+      ctx.notified->push_back( notify_account );
+   }
+
+   template<typename... Names>
+   inline void require_recipient( name notify_account, Names... remaining ) {
+      require_recipient( notify_account );
+      require_recipient( remaining... );
+   }
+
+namespace native {
+
+   template<typename T>
+   struct member_function_traits;
+
+   template<typename Class, typename... Params>
+   struct member_function_traits<void ( Class::* )( Params... )> {
+      using contract = Class;
+      using arguments = std::tuple<std::decay_t<Params>...>;
+   };
+
+   /**
+    * Build a typed entry point calling `Action` on a `Contract` constructed for (receiver, code)
+    */
+   template<auto Action>
+   inline auto make_apply() {
+      using traits = member_function_traits<decltype( Action )>;
+      return []( name receiver, name code, const std::any& data ) {
+         typename traits::contract obj( receiver, code, datastream<const char*>( nullptr, 0 ) );
+         std::apply( [&]( const auto&... args ) { ( obj.*Action )( args... ); }, std::any_cast<const typename traits::arguments&>( data ) );
+      };
+   }
+
+} // namespace native
+
+   template<name::raw Name, auto Action>
+   struct action_wrapper {
+      using traits = native::member_function_traits<decltype( Action )>;
+
+      template<typename Code>
+      constexpr action_wrapper( Code&& code, std::vector<permission_level>&& perms ) : code_name( std::forward<Code>( code ) ), permissions( std::move( perms ) ) {}
+
+      template<typename Code>
+      constexpr action_wrapper( Code&& code, const std::vector<permission_level>& perms ) : code_name( std::forward<Code>( code ) ), permissions( perms ) {}
+
+      template<typename Code>
+      constexpr action_wrapper( Code&& code, permission_level&& perm ) : code_name( std::forward<Code>( code ) ), permissions( { 1, std::move( perm ) } ) {}
+
+      template<typename Code>
+      constexpr action_wrapper( Code&& code, const permission_level& perm ) : code_name( std::forward<Code>( code ) ), permissions( { 1, perm } ) {}
+
+      static constexpr eosio::name action_name = eosio::name( Name );
+      eosio::name code_name;
+      std::vector<permission_level> permissions;
+
+      template<typename... Args>
+      action to_action( Args&&... args ) const {
+         static_assert( sizeof...( Args ) == std::tuple_size_v<typename traits::arguments>, "invalid number of action arguments" );
+         action act;
+         act.account = code_name;
+         act.name = action_name;
+         act.authorization = permissions;
+         act.data = typename traits::arguments( std::forward<Args>( args )... );
+         act.contract_type = &typeid( typename traits::contract );
+         act.apply = native::make_apply<Action>();
+         return act;
+      }
+
+      template<typename... Args>
+      void send( Args&&... args ) const {
+         to_action( std::forward<Args>( args )... ).send();
+      }
+   };
+
+} // namespace eosio
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "symbol.hpp"
+
+#include <string>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace eosio {
+
+   /**
+    * Token quantity, arithmetic & range checks follow the CDT `eosio::asset`
+    */
+   struct asset {
+      int64_t amount = 0;
+      eosio::symbol symbol;
+
+      static constexpr int64_t max_amount = ( 1LL << 62 ) - 1;
+
+      asset() {}
+      asset( int64_t a, class symbol s ) : amount( a ), symbol{ s } {
+         check( is_amount_within_range(), "magnitude of asset amount must be less than 2^62" );
+         check( symbol.is_valid(), "invalid symbol name" );
+      }
+
+      bool is_amount_within_range() const { return -max_amount <= amount && amount <= max_amount; }
+      bool is_valid() const { return is_amount_within_range() && symbol.is_valid(); }
+
+      void set_amount( int64_t a ) {
+         amount = a;
+         check( is_amount_within_range(), "magnitude of asset amount must be less than 2^62" );
+      }
+
+      asset operator-() const {
+         asset r = *this;
+         r.amount = -r.amount;
+         return r;
+      }
+
+      asset& operator-=( const asset& a ) {
+         check( a.symbol == symbol, "attempt to subtract asset with different symbol" );
+         amount -= a.amount;
+         check( -max_amount <= amount, "subtraction underflow" );
+         check( amount <= max_amount, "subtraction overflow" );
+         return *this;
+      }
+
+      asset& operator+=( const asset& a ) {
+         check( a.symbol == symbol, "attempt to add asset with different symbol" );
+         amount += a.amount;
+         check( -max_amount <= amount, "addition underflow" );
+         check( amount <= max_amount, "addition overflow" );
+         return *this;
+      }
+
+      friend asset operator+( const asset& a, const asset& b ) {
+         asset result = a;
+         result += b;
+         return result;
+      }
+
+      friend asset operator-( const asset& a, const asset& b ) {
+         asset result = a;
+         result -= b;
+         return result;
+      }
+
+      asset& operator*=( int64_t a ) {
+         const int128_t tmp = (int128_t)amount * (int128_t)a;
+         check( tmp <= max_amount, "multiplication overflow" );
+         check( tmp >= -max_amount, "multiplication underflow" );
+         amount = (int64_t)tmp;
+         return *this;
+      }
+
+      friend asset operator*( const asset& a, int64_t b ) {
+         asset result = a;
+         result *= b;
+         return result;
+      }
+
+      asset& operator/=( int64_t a ) {
+         check( a != 0, "divide by zero" );
+         check( !( amount == std::numeric_limits<int64_t>::min() && a == -1 ), "signed division overflow" );
+         amount /= a;
+         return *this;
+      }
+
+      friend asset operator/( const asset& a, int64_t b ) {
+         asset result = a;
+         result /= b;
+         return result;
+      }
+
+      friend int64_t operator/( const asset& a, const asset& b ) {
+         check( b.amount != 0, "divide by zero" );
+         check( a.symbol == b.symbol, "comparison of assets with different symbols is not allowed" );
+         return a.amount / b.amount;
+      }
+
+      friend bool operator==( const asset& a, const asset& b ) { return std::tie( a.amount, a.symbol ) == std::tie( b.amount, b.symbol ); }
+      friend bool operator!=( const asset& a, const asset& b ) { return !( a == b ); }
+
+      friend bool operator<( const asset& a, const asset& b ) {
+         check( a.symbol == b.symbol, "comparison of assets with different symbols is not allowed" );
+         return a.amount < b.amount;
+      }
+      friend bool operator<=( const asset& a, const asset& b ) {
+         check( a.symbol == b.symbol, "comparison of assets with different symbols is not allowed" );
+         return a.amount <= b.amount;
+      }
+      friend bool operator>( const asset& a, const asset& b ) {
+         check( a.symbol == b.symbol, "comparison of assets with different symbols is not allowed" );
+         return a.amount > b.amount;
+      }
+      friend bool operator>=( const asset& a, const asset& b ) {
+         check( a.symbol == b.symbol, "comparison of assets with different symbols is not allowed" );
+         return a.amount >= b.amount;
+      }
+
+      std::string to_string() const {
+         const bool negative = amount < 0;
+         const uint64_t abs_amount = negative ? -(uint64_t)amount : amount;
+         const uint8_t precision = symbol.precision();
+
+         std::string digits = std::to_string( abs_amount );
+         if ( precision ) {
+            if ( digits.size() <= precision ) digits.insert( 0, precision + 1 - digits.size(), '0' );
+            digits.insert( digits.size() - precision, 1, '.' );
+         }
+         return ( negative ? "-" : "" ) + digits + " " + symbol.code().to_string();
+      }
+   };
+
+   /**
+    * Token quantity bound to the token contract that issues it
+    */
+   struct extended_asset {
+      asset quantity;
+      name contract;
+
+      extended_asset() = default;
+      extended_asset( int64_t v, extended_symbol s ) : quantity( v, s.get_symbol() ), contract( s.get_contract() ) {}
+      extended_asset( asset a, name c ) : quantity( a ), contract( c ) {}
+
+      extended_symbol get_extended_symbol() const { return extended_symbol{ quantity.symbol, contract }; }
+
+      extended_asset operator-() const { return { -quantity, contract }; }
+
+      friend extended_asset operator-( const extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         return { a.quantity - b.quantity, a.contract };
+      }
+
+      friend extended_asset operator+( const extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         return { a.quantity + b.quantity, a.contract };
+      }
+
+      friend extended_asset& operator+=( extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         a.quantity += b.quantity;
+         return a;
+      }
+
+      friend extended_asset& operator-=( extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         a.quantity -= b.quantity;
+         return a;
+      }
+
+      friend bool operator<( const extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         return a.quantity < b.quantity;
+      }
+      friend bool operator==( const extended_asset& a, const extended_asset& b ) { return std::tie( a.quantity, a.contract ) == std::tie( b.quantity, b.contract ); }
+      friend bool operator!=( const extended_asset& a, const extended_asset& b ) { return !( a == b ); }
+      friend bool operator<=( const extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         return a.quantity <= b.quantity;
+      }
+      friend bool operator>=( const extended_asset& a, const extended_asset& b ) {
+         check( a.contract == b.contract, "type mismatch" );
+         return a.quantity >= b.quantity;
+      }
+
+      std::string to_string() const { return quantity.to_string() + "@" + contract.to_string(); }
+   };
+
+} // namespace eosio
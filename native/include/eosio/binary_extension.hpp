@@ -0,0 +1,64 @@
+#pragma once
+
+#include "check.hpp"
+
+#include <utility>
+
+namespace eosio {
+
+   /**
+    * ## `binary_extension`
+    *
+    * Trailing field which is missing from rows (or actions) serialized before the field was added
+    * Native rows are never serialized, `reset()` stands in for a row written by an older contract
+    */
+   template<typename T>
+   class binary_extension {
+   public:
+      using value_type = T;
+
+      constexpr binary_extension() = default;
+      constexpr binary_extension( const T& ext ) : _has_value( true ), _value( ext ) {}
+      constexpr binary_extension( T&& ext ) : _has_value( true ), _value( std::move( ext ) ) {}
+
+      constexpr bool has_value() const { return _has_value; }
+      constexpr explicit operator bool() const { return _has_value; }
+
+      constexpr T& value() & {
+         check( _has_value, "cannot get value of empty binary_extension" );
+         return _value;
+      }
+
+      constexpr const T& value() const & {
+         check( _has_value, "cannot get value of empty binary_extension" );
+         return _value;
+      }
+
+      template<typename U>
+      constexpr T value_or( U&& def ) const {
+         return _has_value ? _value : static_cast<T>( std::forward<U>( def ) );
+      }
+
+      constexpr T& operator*() & { return value(); }
+      constexpr const T& operator*() const & { return value(); }
+      constexpr T* operator->() { return &value(); }
+      constexpr const T* operator->() const { return &value(); }
+
+      template<typename... Args>
+      T& emplace( Args&&... args ) {
+         _value = T( std::forward<Args>( args )... );
+         _has_value = true;
+         return _value;
+      }
+
+      void reset() {
+         _value = T();
+         _has_value = false;
+      }
+
+   private:
+      bool _has_value = false;
+      T    _value{};
+   };
+
+} // namespace eosio
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+typedef unsigned __int128 uint128_t;
+typedef __int128 int128_t;
+
+namespace eosio {
+
+   /**
+    * Thrown by `check` when an assertion fails, the native equivalent of `eosio_assert` aborting the transaction
+    */
+   struct eosio_assert_message_exception : std::runtime_error {
+      using std::runtime_error::runtime_error;
+   };
+
+   inline void check( bool pred, const char* msg ) {
+      if ( !pred ) throw eosio_assert_message_exception( msg );
+   }
+
+   inline void check( bool pred, const std::string& msg ) {
+      if ( !pred ) throw eosio_assert_message_exception( msg );
+   }
+
+   inline void check( bool pred, const char* msg, size_t n ) {
+      if ( !pred ) throw eosio_assert_message_exception( std::string( msg, n ) );
+   }
+
+   inline void check( bool pred, uint64_t code ) {
+      if ( !pred ) throw eosio_assert_message_exception( "assertion failure with error code: " + std::to_string( code ) );
+   }
+
+} // namespace eosio
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "action.hpp"
+#include "check.hpp"
+#include "contract.hpp"
+#include "multi_index.hpp"
+#include "name.hpp"
+#include "print.hpp"
+#include "system.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
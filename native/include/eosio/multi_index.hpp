@@ -0,0 +1,155 @@
+#pragma once
+
+#include "native/runtime.hpp"
+#include "system.hpp"
+
+#include <iterator>
+#include <map>
+#include <memory>
+
+namespace eosio {
+
+   /**
+    * ## `multi_index`
+    *
+    * Primary-key only `multi_index` backed by `native::database`
+    * Objects are shared by every `multi_index` instance of the same table & modified in place
+    */
+   template<name::raw TableName, typename T, typename... Indices>
+   class multi_index {
+      static_assert( sizeof...( Indices ) == 0, "native multi_index does not support secondary indices" );
+
+      using rows_type = std::map<uint64_t, std::unique_ptr<T>>;
+
+      name     _code;
+      uint64_t _scope;
+
+      native::table<T>& table() const {
+         return native::db().template get_table<T>( _code.value, _scope, static_cast<uint64_t>( TableName ) );
+      }
+
+      void check_writable() const {
+         check( _code == current_receiver(), "cannot modify objects in table of another contract" );
+      }
+
+   public:
+      class const_iterator {
+      public:
+         using iterator_category = std::bidirectional_iterator_tag;
+         using value_type = const T;
+         using difference_type = std::ptrdiff_t;
+         using pointer = const T*;
+         using reference = const T&;
+
+         const_iterator() = default;
+         explicit const_iterator( typename rows_type::const_iterator itr ) : _itr( itr ) {}
+
+         const T& operator*() const { return *_itr->second; }
+         const T* operator->() const { return _itr->second.get(); }
+
+         const_iterator& operator++() { ++_itr; return *this; }
+         const_iterator& operator--() { --_itr; return *this; }
+         const_iterator operator++( int ) { const_iterator result = *this; ++_itr; return result; }
+         const_iterator operator--( int ) { const_iterator result = *this; --_itr; return result; }
+
+         friend bool operator==( const const_iterator& a, const const_iterator& b ) { return a._itr == b._itr; }
+         friend bool operator!=( const const_iterator& a, const const_iterator& b ) { return a._itr != b._itr; }
+
+      private:
+         friend class multi_index;
+         typename rows_type::const_iterator _itr;
+      };
+
+      multi_index( name code, uint64_t scope ) : _code( code ), _scope( scope ) {}
+
+      name get_code() const { return _code; }
+      uint64_t get_scope() const { return _scope; }
+
+      const_iterator begin() const { return const_iterator( table().rows.cbegin() ); }
+      const_iterator end() const { return const_iterator( table().rows.cend() ); }
+      const_iterator cbegin() const { return begin(); }
+      const_iterator cend() const { return end(); }
+
+      const_iterator find( uint64_t primary ) const { return const_iterator( table().rows.find( primary ) ); }
+      const_iterator lower_bound( uint64_t primary ) const { return const_iterator( table().rows.lower_bound( primary ) ); }
+      const_iterator upper_bound( uint64_t primary ) const { return const_iterator( table().rows.upper_bound( primary ) ); }
+
+      const_iterator require_find( uint64_t primary, const char* error_msg = "unable to find key" ) const {
+         auto itr = find( primary );
+         check( itr != end(), error_msg );
+         return itr;
+      }
+
+      const T& get( uint64_t primary, const char* error_msg = "unable to find key" ) const {
+         auto itr = find( primary );
+         check( itr != end(), error_msg );
+         return *itr;
+      }
+
+      uint64_t available_primary_key() const {
+         const auto& rows = table().rows;
+         return rows.empty() ? 0 : rows.rbegin()->first + 1;
+      }
+
+      template<typename Lambda>
+      const_iterator emplace( name payer, Lambda&& constructor ) {
+         check_writable();
+         check( payer.value != 0, "must specify a valid account to pay for new record" );
+
+         auto obj = std::make_unique<T>();
+         constructor( *obj );
+         const uint64_t pk = obj->primary_key();
+
+         auto& rows = table().rows;
+         check( rows.find( pk ) == rows.end(), "could not insert object, most likely a uniqueness constraint was violated" );
+         auto itr = rows.emplace( pk, std::move( obj ) ).first;
+
+         native::db().undo_log.push_back( [&rows, pk]() { rows.erase( pk ); } );
+         return const_iterator( itr );
+      }
+
+      template<typename Lambda>
+      void modify( const_iterator itr, name payer, Lambda&& updater ) {
+         check( itr != end(), "cannot pass end iterator to modify" );
+         modify( *itr, payer, std::forward<Lambda>( updater ) );
+      }
+
+      template<typename Lambda>
+      void modify( const T& obj, name payer, Lambda&& updater ) {
+         check_writable();
+         const uint64_t pk = obj.primary_key();
+         auto& rows = table().rows;
+         auto itr = rows.find( pk );
+         check( itr != rows.end() && itr->second.get() == &obj, "object passed to modify is not in multi_index" );
+
+         T& mutable_obj = *itr->second;
+         auto previous = std::make_shared<T>( mutable_obj );
+         updater( mutable_obj );
+         check( pk == mutable_obj.primary_key(), "updater cannot change primary key when modifying an object" );
+
+         native::db().undo_log.push_back( [&mutable_obj, previous]() { mutable_obj = *previous; } );
+      }
+
+      const_iterator erase( const_iterator itr ) {
+         check( itr != end(), "cannot pass end iterator to erase" );
+         const_iterator next = itr;
+         ++next;
+         erase( *itr );
+         return next;
+      }
+
+      void erase( const T& obj ) {
+         check_writable();
+         const uint64_t pk = obj.primary_key();
+         auto& rows = table().rows;
+         auto itr = rows.find( pk );
+         check( itr != rows.end() && itr->second.get() == &obj, "object passed to erase is not in multi_index" );
+
+         // keep the object alive until the transaction is committed or reverted
+         auto removed = std::make_shared<std::unique_ptr<T>>( std::move( itr->second ) );
+         rows.erase( itr );
+         native::db().undo_log.push_back( [&rows, pk, removed]() { rows.emplace( pk, std::move( *removed ) ); } );
+      }
+   };
+
+} // namespace eosio
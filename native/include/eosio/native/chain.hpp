@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../action.hpp"
+#include "../eosio.hpp"
+
+#include <typeinfo>
+
+namespace eosio::native {
+
+   /**
+    * ## `chain`
+    *
+    * In-process replacement of `nodeos` + `cleos`, resets the shared runtime on construction
+    *
+    * ### example
+    *
+    * ```c++
+    * native::chain chain;
+    * chain.create_account( "eosio.token"_n );
+    * chain.set_code<eosio::token>( "eosio.token"_n );
+    * chain.push_action( eosio::token::create_action{ "eosio.token"_n, { "eosio.token"_n, "active"_n }}.to_action( "eosio"_n, asset{ 100, symbol{"A", 4} } ) );
+    * ```
+    */
+   class chain {
+   public:
+      chain() {
+         auto& r = rt();
+         r.db.rollback();
+         r.db.tables.clear();
+         r.accounts.clear();
+         r.traces.clear();
+         r.context = nullptr;
+         r.depth = 0;
+         r.now = 1609459200000000ll;
+         create_account( "eosio"_n );
+      }
+
+      void create_account( name account ) {
+         rt().accounts[account];
+      }
+
+      template<typename Contract>
+      void set_code( name account ) {
+         check( is_account( account ), "account " + account.to_string() + " does not exist" );
+         rt().accounts[account].contract_type = &typeid( Contract );
+      }
+
+      // register `[[eosio::on_notify("<code>::<action>")]]` handler, empty `code` is the `*` wildcard
+      template<auto Handler>
+      void set_notify( name account, name code, name action ) {
+         rt().accounts[account].notify_handlers.push_back( { code, action, make_apply<Handler>() } );
+      }
+
+      // grants `contract@eosio.code` on `account@active`
+      void add_code_permission( name account, name contract ) {
+         rt().accounts[account].code_permissions.insert( contract );
+      }
+
+      void produce_block( microseconds elapsed = milliseconds( 500 ) ) {
+         rt().now += elapsed.count();
+      }
+
+      time_point now() const {
+         return time_point( microseconds( rt().now ) );
+      }
+
+      const std::vector<action_trace>& push_transaction( const std::vector<action>& actions ) {
+         rt().push_transaction( actions );
+         return rt().traces;
+      }
+
+      const std::vector<action_trace>& push_action( const action& act ) {
+         return push_transaction( { act } );
+      }
+
+      // returns assertion message, empty if the transaction succeeded
+      std::string push_action_error( const action& act ) {
+         try {
+            push_action( act );
+         } catch ( const eosio_assert_message_exception& e ) {
+            return e.what();
+         }
+         return {};
+      }
+
+      const std::vector<action_trace>& traces() const {
+         return rt().traces;
+      }
+
+      // arguments of every `Action` executed by the last transaction (notifications excluded)
+      template<auto Action>
+      std::vector<typename member_function_traits<decltype( Action )>::arguments> actions() const {
+         using arguments = typename member_function_traits<decltype( Action )>::arguments;
+         std::vector<arguments> result;
+         for ( const auto& trace : rt().traces ) {
+            if ( trace.receiver != trace.account ) continue;
+            if ( const auto* args = std::any_cast<arguments>( &trace.data ) ) result.push_back( *args );
+         }
+         return result;
+      }
+   };
+
+} // namespace eosio::native
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "../name.hpp"
+#include "../time.hpp"
+#include "../print.hpp"
+
+#include <any>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <vector>
+
+namespace eosio {
+
+   struct permission_level {
+      permission_level( name a, name p ) : actor( a ), permission( p ) {}
+      permission_level() {}
+
+      name actor;
+      name permission;
+
+      friend bool operator==( const permission_level& a, const permission_level& b ) { return a.actor == b.actor && a.permission == b.permission; }
+      friend bool operator<( const permission_level& a, const permission_level& b ) { return std::tie( a.actor, a.permission ) < std::tie( b.actor, b.permission ); }
+   };
+
+   template<typename T>
+   class datastream {
+   public:
+      datastream( T start, size_t s ) : _start( start ), _pos( start ), _end( start + s ) {}
+      size_t remaining() const { return _end - _pos; }
+
+   private:
+      T _start;
+      T _pos;
+      T _end;
+   };
+
+   /**
+    * Action & its arguments, arguments are kept as a `std::tuple` instead of a serialized byte stream
+    */
+   struct action {
+      eosio::name                   account;
+      eosio::name                   name;
+      std::vector<permission_level> authorization;
+      std::any                      data;
+
+      // contract class which implements the action & typed entry point on that class
+      const std::type_info*         contract_type = nullptr;
+      std::function<void( eosio::name receiver, eosio::name code, const std::any& data )> apply;
+
+      void send() const;
+   };
+
+namespace native {
+
+   /**
+    * ## `database`
+    *
+    * In-memory replacement of the chain state database, tables are keyed by (code, scope, table)
+    * Every write is journaled so a failed transaction can be reverted
+    */
+   struct table_base {
+      virtual ~table_base() = default;
+   };
+
+   template<typename T>
+   struct table : table_base {
+      std::map<uint64_t, std::unique_ptr<T>> rows;
+   };
+
+   struct database {
+      std::map<std::tuple<uint64_t, uint64_t, uint64_t>, std::unique_ptr<table_base>> tables;
+      std::vector<std::function<void()>> undo_log;
+
+      template<typename T>
+      table<T>& get_table( uint64_t code, uint64_t scope, uint64_t tbl ) {
+         auto& ptr = tables[{ code, scope, tbl }];
+         if ( !ptr ) ptr = std::make_unique<table<T>>();
+         auto* t = dynamic_cast<table<T>*>( ptr.get() );
+         check( t != nullptr, "native::database: table row type mismatch" );
+         return *t;
+      }
+
+      void commit() { undo_log.clear(); }
+
+      void rollback() {
+         for ( auto itr = undo_log.rbegin(); itr != undo_log.rend(); ++itr ) ( *itr )();
+         undo_log.clear();
+      }
+   };
+
+   struct notify_handler {
+      name code;     // empty name matches any contract (`*::action`)
+      name action;
+      std::function<void( name receiver, name code, const std::any& data )> apply;
+   };
+
+   struct account_info {
+      const std::type_info*       contract_type = nullptr;
+      std::vector<notify_handler> notify_handlers;
+      std::set<name>              code_permissions;   // contracts with `eosio.code` on this account's active permission
+   };
+
+   struct action_trace {
+      name        receiver;
+      name        account;
+      name        action;
+      std::any    data;
+      std::string console;
+   };
+
+   struct apply_context {
+      name                           receiver;
+      name                           code;
+      const action*                  act = nullptr;
+      std::vector<name>*             notified = nullptr;
+      std::vector<eosio::action>*    inline_actions = nullptr;
+   };
+
+   /**
+    * ## `runtime`
+    *
+    * Chain state shared by the shimmed intrinsics (`require_auth`, `multi_index`, `current_time_point`, ...)
+    */
+   struct runtime {
+      database                       db;
+      std::map<name, account_info>   accounts;
+      int64_t                        now = 1609459200000000ll;   // 2021-01-01T00:00:00
+      apply_context*                 context = nullptr;
+      std::vector<action_trace>      traces;
+      uint32_t                       max_depth = 4;
+      uint32_t                       depth = 0;
+
+      void execute( const eosio::action& act );
+
+      void push_transaction( const std::vector<eosio::action>& actions ) {
+         traces.clear();
+         try {
+            for ( const auto& act : actions ) {
+               for ( const auto& auth : act.authorization ) check( accounts.count( auth.actor ), "missing authority of " + auth.actor.to_string() );
+               execute( act );
+            }
+         } catch ( ... ) {
+            context = nullptr;
+            depth = 0;
+            db.rollback();
+            throw;
+         }
+         db.commit();
+      }
+   };
+
+   inline runtime& rt() {
+      static runtime instance;
+      return instance;
+   }
+
+   inline database& db() { return rt().db; }
+
+   inline apply_context& context() {
+      check( rt().context != nullptr, "native::runtime: no action is executing" );
+      return *rt().context;
+   }
+
+   inline void runtime::execute( const eosio::action& act ) {
+      check( depth < max_depth, "max inline action depth per transaction reached" );
+      const auto account = accounts.find( act.account );
+      check( account != accounts.end(), "account " + act.account.to_string() + " does not exist" );
+      check( account->second.contract_type && act.contract_type && *account->second.contract_type == *act.contract_type,
+             "native::runtime: no matching contract for " + act.account.to_string() + "::" + act.name.to_string() );
+
+      std::vector<name> notified{ act.account };
+      std::vector<eosio::action> inline_actions;
+      apply_context* parent = context;
+      depth++;
+
+      for ( size_t i = 0; i < notified.size(); ++i ) {
+         apply_context ctx{ notified[i], act.account, &act, &notified, &inline_actions };
+         context = &ctx;
+         console().str( "" );
+
+         if ( i == 0 ) act.apply( ctx.receiver, ctx.code, act.data );
+         else {
+            const auto receiver = accounts.find( ctx.receiver );
+            if ( receiver != accounts.end() ) {
+               for ( const auto& handler : receiver->second.notify_handlers ) {
+                  if ( handler.action != act.name ) continue;
+                  if ( handler.code.value && handler.code != act.account ) continue;
+                  handler.apply( ctx.receiver, ctx.code, act.data );
+               }
+            }
+         }
+         traces.push_back( { ctx.receiver, act.account, act.name, act.data, console().str() } );
+      }
+      context = parent;
+
+      for ( const auto& inline_action : inline_actions ) execute( inline_action );
+      depth--;
+   }
+
+} // namespace native
+
+   inline void action::send() const {
+      auto& ctx = native::context();
+      for ( const auto& auth : authorization ) {
+         if ( auth.actor == ctx.receiver ) continue;
+         const auto actor = native::rt().accounts.find( auth.actor );
+         check( actor != native::rt().accounts.end() && actor->second.code_permissions.count( ctx.receiver ),
+                "missing authority of " + auth.actor.to_string() + " (" + ctx.receiver.to_string() + "@eosio.code)" );
+      }
+      ctx.inline_actions->push_back( *this );
+   }
+
+} // namespace eosio
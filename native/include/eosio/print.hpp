@@ -0,0 +1,43 @@
+#pragma once
+
+#include "asset.hpp"
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace eosio {
+   namespace native {
+      /**
+       * Console output of the action currently executing (`--contracts-console` equivalent)
+       */
+      inline std::ostringstream& console() {
+         static std::ostringstream out;
+         return out;
+      }
+   }
+
+   inline void print_one( const char* s ) { native::console() << s; }
+   inline void print_one( const std::string& s ) { native::console() << s; }
+   inline void print_one( std::string_view s ) { native::console() << s; }
+   inline void print_one( bool v ) { native::console() << ( v ? "true" : "false" ); }
+   inline void print_one( const name& v ) { native::console() << v.to_string(); }
+   inline void print_one( const symbol_code& v ) { native::console() << v.to_string(); }
+   inline void print_one( const symbol& v ) { native::console() << v.to_string(); }
+   inline void print_one( const extended_symbol& v ) { native::console() << v.to_string(); }
+   inline void print_one( const asset& v ) { native::console() << v.to_string(); }
+   inline void print_one( const extended_asset& v ) { native::console() << v.to_string(); }
+
+   template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+   inline void print_one( T v ) {
+      if constexpr ( std::is_same_v<T, char> ) native::console() << v;
+      else if constexpr ( std::is_integral_v<T> && sizeof(T) == 1 ) native::console() << static_cast<int>( v );
+      else native::console() << v;
+   }
+
+   template<typename... Args>
+   inline void print( Args&&... args ) {
+      ( print_one( std::forward<Args>( args ) ), ... );
+   }
+
+} // namespace eosio
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "native/runtime.hpp"
+#include "time.hpp"
+
+namespace eosio {
+
+   inline time_point current_time_point() {
+      return time_point( microseconds( native::rt().now ) );
+   }
+
+   inline time_point_sec current_time_point_sec() {
+      return time_point_sec( current_time_point() );
+   }
+
+   inline bool is_account( name n ) {
+      return native::rt().accounts.count( n ) > 0;
+   }
+
+   inline name current_receiver() {
+      return native::context().receiver;
+   }
+
+} // namespace eosio
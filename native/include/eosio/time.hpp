@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace eosio {
+
+   class microseconds {
+   public:
+      explicit microseconds( int64_t c = 0 ) : _count( c ) {}
+
+      int64_t count() const { return _count; }
+      int64_t to_seconds() const { return _count / 1000000; }
+
+      microseconds& operator+=( const microseconds& c ) { _count += c._count; return *this; }
+      microseconds& operator-=( const microseconds& c ) { _count -= c._count; return *this; }
+
+      friend microseconds operator+( const microseconds& l, const microseconds& r ) { return microseconds( l._count + r._count ); }
+      friend microseconds operator-( const microseconds& l, const microseconds& r ) { return microseconds( l._count - r._count ); }
+      friend bool operator==( const microseconds& l, const microseconds& r ) { return l._count == r._count; }
+      friend bool operator!=( const microseconds& l, const microseconds& r ) { return l._count != r._count; }
+      friend bool operator<( const microseconds& l, const microseconds& r ) { return l._count < r._count; }
+      friend bool operator<=( const microseconds& l, const microseconds& r ) { return l._count <= r._count; }
+      friend bool operator>( const microseconds& l, const microseconds& r ) { return l._count > r._count; }
+      friend bool operator>=( const microseconds& l, const microseconds& r ) { return l._count >= r._count; }
+
+      int64_t _count;
+   };
+
+   inline microseconds milliseconds( int64_t s ) { return microseconds( s * 1000 ); }
+   inline microseconds seconds( int64_t s ) { return milliseconds( s * 1000 ); }
+   inline microseconds minutes( int64_t m ) { return seconds( 60 * m ); }
+   inline microseconds hours( int64_t h ) { return minutes( 60 * h ); }
+   inline microseconds days( int64_t d ) { return hours( 24 * d ); }
+
+   class time_point {
+   public:
+      explicit time_point( microseconds e = microseconds() ) : elapsed( e ) {}
+
+      const microseconds& time_since_epoch() const { return elapsed; }
+      uint32_t sec_since_epoch() const { return uint32_t( elapsed.count() / 1000000 ); }
+
+      time_point& operator+=( const microseconds& m ) { elapsed += m; return *this; }
+      time_point& operator-=( const microseconds& m ) { elapsed -= m; return *this; }
+      time_point operator+( const microseconds& m ) const { return time_point( elapsed + m ); }
+      time_point operator-( const microseconds& m ) const { return time_point( elapsed - m ); }
+      microseconds operator-( const time_point& m ) const { return microseconds( elapsed.count() - m.elapsed.count() ); }
+
+      bool operator==( const time_point& t ) const { return elapsed == t.elapsed; }
+      bool operator!=( const time_point& t ) const { return elapsed != t.elapsed; }
+      bool operator<( const time_point& t ) const { return elapsed < t.elapsed; }
+      bool operator<=( const time_point& t ) const { return elapsed <= t.elapsed; }
+      bool operator>( const time_point& t ) const { return elapsed > t.elapsed; }
+      bool operator>=( const time_point& t ) const { return elapsed >= t.elapsed; }
+
+      microseconds elapsed;
+   };
+
+   class time_point_sec {
+   public:
+      time_point_sec() : utc_seconds( 0 ) {}
+      explicit time_point_sec( uint32_t seconds ) : utc_seconds( seconds ) {}
+      time_point_sec( const time_point& t ) : utc_seconds( uint32_t( t.time_since_epoch().count() / 1000000ll ) ) {}
+
+      static time_point_sec maximum() { return time_point_sec( 0xffffffff ); }
+      static time_point_sec min() { return time_point_sec( 0 ); }
+
+      operator time_point() const { return time_point( eosio::seconds( utc_seconds ) ); }
+      uint32_t sec_since_epoch() const { return utc_seconds; }
+
+      time_point_sec& operator=( const time_point& t ) {
+         utc_seconds = uint32_t( t.time_since_epoch().count() / 1000000ll );
+         return *this;
+      }
+      time_point_sec& operator+=( uint32_t m ) { utc_seconds += m; return *this; }
+      time_point_sec& operator-=( uint32_t m ) { utc_seconds -= m; return *this; }
+      time_point_sec operator+( uint32_t offset ) const { return time_point_sec( utc_seconds + offset ); }
+      time_point_sec operator-( uint32_t offset ) const { return time_point_sec( utc_seconds - offset ); }
+
+      friend time_point operator+( const time_point_sec& t, const microseconds& m ) { return time_point( t ) + m; }
+      friend time_point operator-( const time_point_sec& t, const microseconds& m ) { return time_point( t ) - m; }
+      friend bool operator==( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds == b.utc_seconds; }
+      friend bool operator!=( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds != b.utc_seconds; }
+      friend bool operator<( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds < b.utc_seconds; }
+      friend bool operator<=( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds <= b.utc_seconds; }
+      friend bool operator>( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds > b.utc_seconds; }
+      friend bool operator>=( const time_point_sec& a, const time_point_sec& b ) { return a.utc_seconds >= b.utc_seconds; }
+
+      uint32_t utc_seconds;
+   };
+
+} // namespace eosio
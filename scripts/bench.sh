@@ -0,0 +1,155 @@
+#!/bin/bash
+#
+# Per-action CPU regression gate for `curve.sx` on the local chain (scripts/restart.sh + scripts/test.sh)
+#
+# Runs a fixed scenario set on the `scripts/test.sh` pairs (AB, BC, AC, ABC) `-r` times and collects from each
+# transaction trace the billed CPU (µs), NET (words) & RAM delta (bytes). Results are compared against the
+# baseline file: fails when the median CPU of an action exceeds the baseline by more than `-t` percent,
+# or when NET / RAM usage grows at all (both are deterministic). Actions without a baseline entry are only
+# reported (nothing to compare yet), record them with `-u` on the reference node; `-s` fails on them too.
+#
+# usage: ./scripts/bench.sh [-r repetitions] [-t threshold %] [-b baseline] [-u] [-s] [-U url]
+#
+# -u  record the results as the new baseline (commit bench/baseline.txt afterwards)
+# -s  strict: actions without a baseline entry fail the gate
+
+set -o pipefail
+
+REPETITIONS=10
+THRESHOLD=25
+BASELINE=$(dirname "$0")/../bench/baseline.txt
+UPDATE=0
+STRICT=0
+URL=http://127.0.0.1:8888
+
+while getopts "r:t:b:usU:h" opt; do
+  case $opt in
+    r) REPETITIONS=$OPTARG ;;
+    t) THRESHOLD=$OPTARG ;;
+    b) BASELINE=$OPTARG ;;
+    u) UPDATE=1 ;;
+    s) STRICT=1 ;;
+    U) URL=$OPTARG ;;
+    *) sed -n '3,14p' "$0"; exit 1 ;;
+  esac
+done
+
+# variables
+CONTRACT=curve.sx
+LP_CONTRACT=lptoken.sx
+OWNER=myaccount
+
+RESULTS=$(mktemp)
+trap 'rm -f $RESULTS' EXIT
+
+# unlock wallet
+cleos wallet unlock --password $(cat ~/eosio-wallet/.pass) > /dev/null 2>&1
+
+# push one action, appends "<action> <cpu_us> <net_words> <ram_bytes>" to $RESULTS
+measure() {
+  local action=$1 output
+  shift
+  # repetition dependent expiration keeps identical actions (ex: `cancel`) from being duplicate transactions
+  if ! output=$(cleos -u $URL "$@" -x $(( 60 + i )) -j 2>&1); then
+    echo "$action: $(grep -m1 -o "assertion failure with message: .*\|Error [0-9]*: .*" <<< "$output")"
+    exit 1
+  fi
+  jq -r --arg action "$action" '[ $action, .processed.receipt.cpu_usage_us, .processed.receipt.net_usage_words, ([ .processed.action_traces[]?.account_ram_deltas[]?.delta ] | add // 0) ] | join(" ")' <<< "$output" >> $RESULTS
+}
+
+transfer() {
+  local action=$1 contract=$2 quantity=$3 memo=$4
+  measure "$action" push action $contract transfer "[\"$OWNER\", \"$CONTRACT\", \"$quantity\", \"$memo\"]" -p $OWNER
+}
+
+# unique pair id per repetition: BDA, BDB, ...
+pair_id() {
+  printf "BD\\x$(printf %x $(( 65 + $1 % 26 )))"
+}
+
+echo "Running $REPETITIONS repetitions ..."
+for i in $(seq 1 $REPETITIONS); do
+  # offset quantities by the repetition so no transaction is a duplicate
+  n=$(printf "%04d" $i)
+
+  # on_transfer: swaps
+  transfer "on_transfer:swap:AB" eosio.token "1.$n A" "swap,0,AB"
+  transfer "on_transfer:swap:BC" eosio.token "1.$n B" "swap,0,BC"
+  transfer "on_transfer:swap:AC" eosio.token "1.$n A" "swap,0,AC"
+  transfer "on_transfer:swap:ABC" $LP_CONTRACT "1.$n AB" "swap,0,ABC"
+  transfer "on_transfer:swap:AC-BC" eosio.token "1.$n A" "swap,0,AC-BC"
+
+  # on_transfer: deposits & `deposit`
+  transfer "on_transfer:deposit" eosio.token "1.$n A" "deposit,AB"
+  transfer "on_transfer:deposit" eosio.token "1.$n B" "deposit,AB"
+  measure "deposit" push action $CONTRACT deposit "[\"$OWNER\", \"AB\", null]" -p $OWNER
+
+  # `cancel`
+  transfer "on_transfer:deposit" eosio.token "1.$n A" "deposit,AB"
+  measure "cancel" push action $CONTRACT cancel "[\"$OWNER\", \"AB\"]" -p $OWNER
+
+  # on_transfer: withdraw
+  transfer "on_transfer:withdraw" $LP_CONTRACT "0.$n AB" ""
+
+  # `ramp` (amplifier unchanged, stopped right after)
+  measure "ramp" push action $CONTRACT ramp "[\"AB\", $(( 20 + i )), 1440]" -p $CONTRACT
+  cleos -u $URL push action $CONTRACT stopramp '["AB"]' -p $CONTRACT -x $(( 60 + i )) > /dev/null
+
+  # `createpair` (removed right after)
+  measure "createpair" push action $CONTRACT createpair "[\"$CONTRACT\", \"$(pair_id $i)\", [\"4,B\", \"eosio.token\"], [\"6,D\", \"eosio.token\"], 100]" -p $CONTRACT
+  cleos -u $URL push action $CONTRACT removepair "[\"$(pair_id $i)\"]" -p $CONTRACT > /dev/null
+done
+
+# median CPU, max NET & RAM per action
+CURRENT=$(mktemp)
+trap 'rm -f $RESULTS $CURRENT' EXIT
+for action in $(awk '{ print $1 }' $RESULTS | sort -u); do
+  cpu=$(awk -v a="$action" '$1 == a { print $2 }' $RESULTS | sort -n)
+  count=$(grep -c . <<< "$cpu")
+  median=$(sed -n "$(( (count + 1) / 2 ))p" <<< "$cpu")
+  net=$(awk -v a="$action" '$1 == a && $3 > m { m = $3 } END { print m + 0 }' $RESULTS)
+  ram=$(awk -v a="$action" '$1 == a && ( !n++ || $4 > m ) { m = $4 } END { print m + 0 }' $RESULTS)
+  echo "$action $median $net $ram"
+done > $CURRENT
+
+if [ $UPDATE -eq 1 ]; then
+  {
+    echo "# action cpu_us net_words ram_bytes (median CPU over $REPETITIONS repetitions, ./scripts/bench.sh -u)"
+    cat $CURRENT
+  } > $BASELINE
+  echo "baseline written to $BASELINE"
+  cat $CURRENT
+  exit 0
+fi
+
+REGRESSIONS=0
+MISSING=0
+printf "%-26s %8s %8s %8s %6s %6s %8s %8s  %s\n" "action" "cpu" "base" "change" "net" "base" "ram" "base" "status"
+while read -r action cpu net ram; do
+  read -r _ base_cpu base_net base_ram <<< "$(grep -v '^#' $BASELINE 2> /dev/null | awk -v a="$action" '$1 == a')"
+  status="ok"
+  if [ -z "$base_cpu" ]; then
+    status="no baseline"
+    change="-"
+    MISSING=$((MISSING + 1))
+  else
+    change=$(awk "BEGIN { printf \"%+.1f%%\", ($cpu - $base_cpu) * 100 / ($base_cpu > 0 ? $base_cpu : 1) }")
+    if awk "BEGIN { exit !($cpu > $base_cpu * (1 + $THRESHOLD / 100)) }"; then status="REGRESSION (cpu)"; fi
+    if [ $net -gt $base_net ]; then status="REGRESSION (net)"; fi
+    if [ $ram -gt $base_ram ]; then status="REGRESSION (ram)"; fi
+  fi
+  [[ $status == REGRESSION* ]] && REGRESSIONS=$((REGRESSIONS + 1))
+  printf "%-26s %8s %8s %8s %6s %6s %8s %8s  %s\n" "$action" $cpu "${base_cpu:--}" "$change" $net "${base_net:--}" $ram "${base_ram:--}" "$status"
+done < $CURRENT
+
+if [ $MISSING -gt 0 ]; then
+  echo
+  echo "$MISSING action(s) have no entry in $BASELINE, not compared (record with ./scripts/bench.sh -u)"
+fi
+if [ $REGRESSIONS -gt 0 ]; then
+  echo
+  echo "$REGRESSIONS action(s) regressed beyond the baseline (cpu threshold: $THRESHOLD%)"
+fi
+if [ $REGRESSIONS -gt 0 ] || ( [ $STRICT -eq 1 ] && [ $MISSING -gt 0 ] ); then
+  exit 1
+fi
@@ -0,0 +1,182 @@
+#!/bin/bash
+#
+# Load generator for `curve.sx` on the local chain (scripts/start_nodeos.sh + scripts/deploy.sh + scripts/test.sh)
+#
+# Creates trader accounts, then submits concurrent swap (1-4 hops), deposit & withdraw transactions
+# Reports achieved TPS, p50/p99 billed CPU (µs) per action type & failed transactions
+#
+# usage: ./scripts/loadgen.sh [-n traders] [-t transactions] [-c concurrency] [-m swap:deposit:withdraw] [-u url]
+#
+# example: ./scripts/loadgen.sh -n 20 -t 5000 -c 16 -m 80:10:10
+
+set -o pipefail
+
+TRADERS=10
+TRANSACTIONS=1000
+CONCURRENCY=8
+MIX="80:10:10"
+URL=http://127.0.0.1:8888
+
+while getopts "n:t:c:m:u:h" opt; do
+  case $opt in
+    n) TRADERS=$OPTARG ;;
+    t) TRANSACTIONS=$OPTARG ;;
+    c) CONCURRENCY=$OPTARG ;;
+    m) MIX=$OPTARG ;;
+    u) URL=$OPTARG ;;
+    *) sed -n '3,10p' "$0"; exit 1 ;;
+  esac
+done
+
+IFS=: read -r SWAP_WEIGHT DEPOSIT_WEIGHT WITHDRAW_WEIGHT <<< "$MIX"
+if [ $((SWAP_WEIGHT + DEPOSIT_WEIGHT + WITHDRAW_WEIGHT)) -le 0 ]; then
+  echo "invalid mix: $MIX"
+  exit 1
+fi
+
+# variables
+CONTRACT=curve.sx
+LP_CONTRACT=lptoken.sx
+PUBLIC_KEY=EOS6MRyAjQq8ud7hVNYcfnVPJqcVpscN5So8BhtHuGYqET5GDW5CV
+
+# swap routes over the `scripts/test.sh` pairs (AB, BC, AC) + AD created below: "<symbol in> <pair_ids>"
+# memo `pair_ids` must be distinct, the 4-hop route A => B => C => A ends with the extra AD pair
+ROUTES=(
+  "A AB"
+  "B BC"
+  "A AC"
+  "A AB-BC"
+  "A AC-BC"
+  "A AB-BC-AC"
+  "A AB-BC-AC-AD"
+)
+
+WORKDIR=$(mktemp -d)
+RESULTS=$WORKDIR/results
+trap 'rm -rf $WORKDIR' EXIT
+
+# unlock wallet
+cleos wallet unlock --password $(cat ~/eosio-wallet/.pass) > /dev/null 2>&1
+
+# trader account names: trader.1 ... trader.5, trader.11 ... (base 5, eosio names only allow 1-5)
+trader_name() {
+  local i=$1 suffix=""
+  while [ $i -gt 0 ]; do
+    suffix="$(( (i - 1) % 5 + 1 ))$suffix"
+    i=$(( (i - 1) / 5 ))
+  done
+  echo "trader.$suffix"
+}
+
+# 4th pair for the 4-hop route (already exists on reruns)
+echo "Creating AD pair ..."
+cleos -u $URL push action $CONTRACT createpair "[$CONTRACT, AD, [\"4,A\", eosio.token], [\"6,D\", eosio.token], 100]" -p $CONTRACT > /dev/null 2>&1
+cleos -u $URL transfer myaccount $CONTRACT "1000.0000 A" "deposit,AD" > /dev/null
+cleos -u $URL transfer myaccount $CONTRACT "1000.000000 D" "deposit,AD" > /dev/null
+cleos -u $URL push action $CONTRACT deposit '["myaccount", "AD", null]' -p myaccount > /dev/null
+
+echo "Creating $TRADERS traders ..."
+for i in $(seq 1 $TRADERS); do
+  trader=$(trader_name $i)
+  cleos -u $URL create account eosio $trader $PUBLIC_KEY > /dev/null 2>&1
+  cleos -u $URL transfer eosio $trader "10000.0000 A" "" > /dev/null
+  cleos -u $URL transfer eosio $trader "10000.0000 B" "" > /dev/null
+  cleos -u $URL transfer eosio $trader "10000.000000000 C" "" > /dev/null
+
+  # seed liquidity so withdrawals have LP tokens to return
+  cleos -u $URL transfer $trader $CONTRACT "100.0000 A" "deposit,AB" > /dev/null
+  cleos -u $URL transfer $trader $CONTRACT "100.0000 B" "deposit,AB" > /dev/null
+  cleos -u $URL push action $CONTRACT deposit "[\"$trader\", \"AB\", null]" -p $trader > /dev/null
+done
+
+# quantity with a per-transaction offset (in smallest units) so identical transfers are never duplicate transactions
+quantity() {
+  local amount=$1 index=$2 precision=$3 symcode=$4
+  printf "%d.%0${precision}d %s" $amount $(( index % (10 ** precision) )) $symcode
+}
+
+transfer_action() {
+  local contract=$1 from=$2 quantity=$3 memo=$4
+  printf '{"account":"%s","name":"transfer","authorization":[{"actor":"%s","permission":"active"}],"data":{"from":"%s","to":"%s","quantity":"%s","memo":"%s"}}' \
+    $contract $from $from $CONTRACT "$quantity" "$memo"
+}
+
+# submit one transaction, appends "<type> <ok|fail> <cpu_us> <net_words> <latency_ms> <error>" to $RESULTS
+submit() {
+  local type=$1 index=$2 trader actions output start end
+  trader=$(trader_name $(( index % TRADERS + 1 )))
+
+  case $type in
+    swap)
+      read -r symcode pair_ids <<< "${ROUTES[$(( RANDOM % ${#ROUTES[@]} ))]}"
+      type="swap:$pair_ids"
+      actions=$(transfer_action eosio.token $trader "$(quantity 1 $index 4 $symcode)" "swap,0,$pair_ids")
+      ;;
+    deposit)
+      actions="$(transfer_action eosio.token $trader "$(quantity 1 $index 4 A)" "deposit,AB"),$(transfer_action eosio.token $trader "$(quantity 1 $index 4 B)" "deposit,AB")"
+      actions="$actions,{\"account\":\"$CONTRACT\",\"name\":\"deposit\",\"authorization\":[{\"actor\":\"$trader\",\"permission\":\"active\"}],\"data\":{\"owner\":\"$trader\",\"pair_id\":\"AB\",\"min_amount\":null}}"
+      ;;
+    withdraw)
+      actions=$(transfer_action $LP_CONTRACT $trader "$(quantity 0 $(( index % 9999 + 1 )) 4 AB)" "")
+      ;;
+  esac
+
+  start=$(date +%s%N)
+  output=$(cleos -u $URL push transaction "{\"actions\":[$actions]}" -j 2>&1)
+  end=$(date +%s%N)
+
+  if cpu=$(jq -er '.processed.receipt.cpu_usage_us' <<< "$output" 2> /dev/null); then
+    net=$(jq -r '.processed.receipt.net_usage_words' <<< "$output")
+    echo "$type ok $cpu $net $(( (end - start) / 1000000 ))" >> $RESULTS
+  else
+    error=$(grep -m1 -o "assertion failure with message: .*\|Error [0-9]*: .*" <<< "$output")
+    echo "$type fail 0 0 $(( (end - start) / 1000000 )) ${error:-unknown}" >> $RESULTS
+  fi
+}
+
+export -f submit transfer_action quantity trader_name
+export URL CONTRACT LP_CONTRACT TRADERS RESULTS
+export ROUTES_LIST=$(printf "%s\n" "${ROUTES[@]}")
+
+# weighted operation list
+echo "Submitting $TRANSACTIONS transactions (mix swap:deposit:withdraw=$MIX, concurrency=$CONCURRENCY) ..."
+TOTAL_WEIGHT=$((SWAP_WEIGHT + DEPOSIT_WEIGHT + WITHDRAW_WEIGHT))
+for i in $(seq 1 $TRANSACTIONS); do
+  r=$(( RANDOM % TOTAL_WEIGHT ))
+  if [ $r -lt $SWAP_WEIGHT ]; then echo "swap $i"
+  elif [ $r -lt $((SWAP_WEIGHT + DEPOSIT_WEIGHT)) ]; then echo "deposit $i"
+  else echo "withdraw $i"
+  fi
+done > $WORKDIR/operations
+
+START=$(date +%s%N)
+xargs -P $CONCURRENCY -L 1 bash -c 'mapfile -t ROUTES <<< "$ROUTES_LIST"; submit "$@"' _ < $WORKDIR/operations
+END=$(date +%s%N)
+
+# report
+ELAPSED_MS=$(( (END - START) / 1000000 ))
+OK=$(grep -c " ok " $RESULTS)
+FAILED=$(grep -c " fail " $RESULTS)
+
+echo
+echo "elapsed:      $(awk "BEGIN { printf \"%.2f\", $ELAPSED_MS / 1000 }") s"
+echo "transactions: $((OK + FAILED)) ($OK ok, $FAILED failed)"
+echo "TPS:          $(awk "BEGIN { printf \"%.1f\", $OK * 1000 / ($ELAPSED_MS > 0 ? $ELAPSED_MS : 1) }")"
+echo
+printf "%-22s %8s %8s %10s %10s %10s\n" "action" "ok" "failed" "cpu p50" "cpu p99" "net words"
+for type in $(awk '{ print $1 }' $RESULTS | sort -u); do
+  cpu=$(awk -v t="$type" '$1 == t && $2 == "ok" { print $3 }' $RESULTS | sort -n)
+  count=$(grep -c . <<< "$cpu")
+  [ -z "$cpu" ] && count=0
+  p50=$( [ $count -gt 0 ] && sed -n "$(( (count * 50 + 99) / 100 ))p" <<< "$cpu" || echo "-")
+  p99=$( [ $count -gt 0 ] && sed -n "$(( (count * 99 + 99) / 100 ))p" <<< "$cpu" || echo "-")
+  net=$(awk -v t="$type" '$1 == t && $2 == "ok" { s += $4; n++ } END { print n ? int(s / n) : "-" }' $RESULTS)
+  failed=$(awk -v t="$type" '$1 == t && $2 == "fail"' $RESULTS | wc -l)
+  printf "%-22s %8d %8d %10s %10s %10s\n" "$type" $count $failed "$p50" "$p99" "$net"
+done
+
+if [ $FAILED -gt 0 ]; then
+  echo
+  echo "failures:"
+  awk '$2 == "fail"' $RESULTS | cut -d' ' -f6- | sort | uniq -c | sort -rn | head -10
+fi
@@ -1,53 +1,92 @@
 namespace sx {
 
-// accounts to be notified via inline action
-void curve::notify()
+// accounts to be notified via inline action: wildcard `notifiers` (validated by `setnotifiers`, no account lookups) & subscribers of `pair_ids`
+void curve::notify( const vector<name>& notifiers, const pair_ids_vector& pair_ids )
 {
-    curve::config_table _config( get_self(), get_self().value );
-    auto config = _config.get_or_default();
-
-    for ( const name notifier : config.notifiers ) {
-        if ( is_account( notifier ) ) require_recipient( notifier );
+    for ( const name notifier : notifiers ) {
+        CURVE_PROFILE_COUNT( recipient, 1 );
+        require_recipient( notifier );
     }
+    for ( const symbol_code pair_id : pair_ids ) {
+        curve::subscribers_table _subscribers( get_self(), pair_id.raw() );
+        for ( const auto& row : _subscribers ) {
+            CURVE_PROFILE_COUNT( recipient, 1 );
+            require_recipient( row.notifier );
+        }
+    }
+}
+
+// log actions only read the compact `notifiers` singleton (`config` fallback until `setnotifiers` has run)
+// `setlognotify` only mutes wildcard notifiers of logs emitted by `on_transfer` (already notified of the transfer), subscribers are always notified
+void curve::notify_logs( const pair_ids_vector& pair_ids, const bool is_transfer )
+{
+    curve::notifiers_table _notifiers( get_self(), get_self().value );
+    const auto notifiers = _notifiers.get_or_default();
+    if ( is_transfer && !notifiers.notify_logs ) return notify( {}, pair_ids );
+    if ( notifiers.accounts.size() ) return notify( notifiers.accounts, pair_ids );
+
+    curve::config_table _config( get_self(), get_self().value );
+    notify( _config.get_or_default().notifiers, pair_ids );
 }
 
 [[eosio::action]]
 void curve::liquiditylog( const symbol_code pair_id, const name owner, const name action, const asset liquidity, const asset quantity0,  const asset quantity1, const asset total_liquidity, const asset reserve0, const asset reserve1 )
 {
+    CURVE_PROFILE_SCOPE( "liquiditylog" );
     require_auth( get_self() );
-    notify();
+    // `deposit` is a standalone action, `withdraw` is sent by `on_transfer`
+    notify_logs( { pair_id }, action != "deposit"_n );
+    CURVE_PROFILE_COUNT( recipient, 1 );
     require_recipient( owner );
 }
 
 [[eosio::action]]
 void curve::swaplog( const symbol_code pair_id, const name owner, const name action, const asset quantity_in, const asset quantity_out, const asset fee, const double trade_price, const asset reserve0, const asset reserve1 )
 {
+    CURVE_PROFILE_SCOPE( "swaplog" );
+    require_auth( get_self() );
+    notify_logs( { pair_id }, true );
+    CURVE_PROFILE_COUNT( recipient, 1 );
+    require_recipient( owner );
+}
+
+[[eosio::action]]
+void curve::routelog( const name owner, const name action, const vector<swap_hop> hops )
+{
+    CURVE_PROFILE_SCOPE( "routelog" );
     require_auth( get_self() );
-    notify();
+    pair_ids_vector pair_ids;
+    for ( const swap_hop& hop : hops ) pair_ids.push_back( hop.pair_id );
+    notify_logs( pair_ids, true );
+    CURVE_PROFILE_COUNT( recipient, 1 );
     require_recipient( owner );
 }
 
 void curve::create( const extended_symbol value )
 {
     eosio::token::create_action create( value.get_contract(), { value.get_contract(), "active"_n });
+    CURVE_PROFILE_COUNT( create, 1 );
     create.send( get_self(), asset{ asset_max, value.get_symbol() } );
 }
 
 void curve::issue( const extended_asset value, const string memo )
 {
     eosio::token::issue_action issue( value.contract, { get_self(), "active"_n });
+    CURVE_PROFILE_COUNT( issue, 1 );
     issue.send( get_self(), value.quantity, memo );
 }
 
 void curve::retire( const extended_asset value, const string memo )
 {
     eosio::token::retire_action retire( value.contract, { get_self(), "active"_n });
+    CURVE_PROFILE_COUNT( retire, 1 );
     retire.send( value.quantity, memo );
 }
 
 void curve::transfer( const name from, const name to, const extended_asset value, const string memo )
 {
     eosio::token::transfer_action transfer( value.contract, { from, "active"_n });
+    CURVE_PROFILE_COUNT( transfer, 1 );
     transfer.send( from, to, value.quantity, memo );
 }
 
@@ -0,0 +1,45 @@
+namespace sx {
+
+// add protocol fee to the accrued balance of its extended symbol (one row per token, kept once claimed)
+void curve::accrue_fee( const extended_asset fee )
+{
+    curve::fees_table _fees( get_self(), fee.contract.value );
+
+    auto itr = _fees.find( fee.quantity.symbol.code().raw() );
+    if ( itr == _fees.end() ) {
+        _fees.emplace( get_self(), [&]( auto & row ) {
+            row.balance = fee;
+        });
+    } else {
+        check( itr->balance.get_extended_symbol() == fee.get_extended_symbol(), "curve::accrue_fee: invalid extended symbol");
+        _fees.modify( itr, get_self(), [&]( auto & row ) {
+            row.balance += fee;
+        });
+    }
+}
+
+// pays all protocol fees accrued in `contract` tokens to `fee_account` (permissionless, fees can only go to `fee_account`)
+[[eosio::action]]
+void curve::claimfees( const name contract )
+{
+    CURVE_PROFILE_SCOPE( "claimfees" );
+
+    curve::config_table _config( get_self(), get_self().value );
+    curve::fees_table _fees( get_self(), contract.value );
+    check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
+    const name fee_account = _config.get().fee_account;
+    check( fee_account.value, "curve::claimfees: `fee_account` is not defined");
+
+    bool claimed = false;
+    for ( auto itr = _fees.begin(); itr != _fees.end(); ++itr ) {
+        if ( !itr->balance.quantity.amount ) continue;
+        transfer( get_self(), fee_account, itr->balance, get_self().to_string() + ": protocol fee");
+        _fees.modify( itr, get_self(), [&]( auto & row ) {
+            row.balance.quantity.amount = 0;
+        });
+        claimed = true;
+    }
+    check( claimed, "curve::claimfees: no fees to claim");
+}
+
+} // namespace sx
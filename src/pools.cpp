@@ -0,0 +1,296 @@
+namespace sx {
+
+[[eosio::action]]
+void curve::createpool( const name creator, const symbol_code pool_id, const vector<extended_symbol> reserves, const uint64_t amplifier )
+{
+    CURVE_PROFILE_SCOPE( "createpool" );
+
+    // `creator` must be contract
+    check( creator == get_self(), "curve::createpool: only contract admin can create pool");
+    require_auth( creator );
+
+    // tables
+    curve::pools_table _pools( get_self(), get_self().value );
+    curve::pairs_table _pairs( get_self(), get_self().value );
+    curve::config_table _config( get_self(), get_self().value );
+    check( _config.exists(), ERROR_CONFIG_NOT_EXISTS );
+    const name token_contract = _config.get().token_contract;
+
+    // check reserves
+    check( reserves.size() >= MIN_POOL_RESERVES && reserves.size() <= MAX_POOL_RESERVES, "curve::createpool: invalid number of reserves" );
+    set<symbol_code> duplicates;
+    uint8_t precision = 0;
+    for ( const extended_symbol reserve : reserves ) {
+        const name contract = reserve.get_contract();
+        const symbol sym = reserve.get_symbol();
+        check( is_account( contract ), "curve::createpool: reserve contract does not exists");
+        check( token::get_supply( contract, sym.code() ).symbol == sym, "curve::createpool: reserve extended symbol mismatch supply" );
+        check( !duplicates.count( sym.code() ), "curve::createpool: invalid duplicate reserves");
+        duplicates.insert( sym.code() );
+        precision = max( precision, sym.precision() );
+    }
+    check( _pools.find( pool_id.raw() ) == _pools.end(), "curve::createpool: `pool_id` already exists" );
+    check( _pairs.find( pool_id.raw() ) == _pairs.end(), "curve::createpool: `pool_id` already exists in `pairs`" );
+    check( amplifier > 0 && amplifier <= MAX_AMPLIFIER, "curve::createpool: invalid amplifier" );
+
+    // create liquidity token
+    const extended_symbol liquidity = {{ pool_id, precision }, token_contract };
+
+    // in case supply already exists
+    token::stats _stats( token_contract, pool_id.raw() );
+    auto stats_itr = _stats.find( pool_id.raw() );
+
+    // create token if supply does not exist
+    if ( stats_itr == _stats.end() ) create( liquidity );
+    // supply must be empty
+    else check( !stats_itr->supply.amount, "curve::createpool: creating new pool requires existing supply to be zero" );
+
+    // create pool
+    _pools.emplace( creator, [&]( auto & row ) {
+        row.id = pool_id;
+        for ( const extended_symbol reserve : reserves ) {
+            row.reserves.push_back({ 0, reserve });
+            row.volumes.push_back({ 0, reserve.get_symbol() });
+        }
+        row.liquidity = { 0, liquidity };
+        row.amplifier = amplifier;
+        row.last_updated = current_time_point();
+    });
+}
+
+[[eosio::action]]
+void curve::removepool( const symbol_code pool_id )
+{
+    CURVE_PROFILE_SCOPE( "removepool" );
+    require_auth( get_self() );
+
+    curve::pools_table _pools( get_self(), get_self().value );
+    auto & pool = _pools.get( pool_id.raw(), "curve::removepool: [pool_id] does not exist");
+    check( pool.liquidity.quantity.amount == 0, "curve::removepool: liquidity amount must be empty");
+    _pools.erase( pool );
+}
+
+void curve::swap_pool( const config_row& config, const name owner, const extended_asset ext_in, const symbol_code pool_id, const symbol_code symcode_out, const int64_t min_return )
+{
+    curve::pools_table _pools( get_self(), get_self().value );
+
+    // input & output reserves
+    const auto& pool = _pools.get( pool_id.raw(), "curve::swap_pool: `pool_id` does not exist");
+    const uint8_t index_in = get_pool_index( pool, ext_in.quantity.symbol.code() );
+    const uint8_t index_out = get_pool_index( pool, symcode_out );
+
+    // validate input quantity & reserves
+    check( pool.reserves[index_in].get_extended_symbol() == ext_in.get_extended_symbol(), "curve::swap_pool: invalid extended symbol");
+    check( index_in != index_out, "curve::swap_pool: input and output reserves must be different");
+    for ( const extended_asset& reserve : pool.reserves ) {
+        check( reserve.quantity.amount != 0, "curve::swap_pool: empty pool reserves");
+    }
+
+    // calculate out
+    const extended_asset ext_out = { get_pool_amount_out( ext_in.quantity, pool, config, symcode_out ), pool.reserves[index_out].contract };
+
+    // enforce minimum return (slippage protection)
+    check( ext_out.quantity.amount != 0 && ext_out.quantity.amount >= min_return, "curve::swap_pool: invalid minimum return");
+
+    // protocol & trade fees
+    const extended_asset protocol_fee = { ext_in.quantity.amount * config.protocol_fee / 10000, ext_in.get_extended_symbol() };
+    const extended_asset trade_fee = { ext_in.quantity.amount * config.trade_fee / 10000, ext_in.get_extended_symbol() };
+    const extended_asset fee = protocol_fee + trade_fee;
+
+    // modify reserves
+    _pools.modify( pool, get_self(), [&]( auto & row ) {
+        // calculate last price
+        const double price = calculate_price( ext_out.quantity, ext_in.quantity );
+
+        row.reserves[index_in].quantity += ext_in.quantity - protocol_fee.quantity;
+        row.reserves[index_out].quantity -= ext_out.quantity;
+        row.volumes[index_in] += ext_in.quantity;
+        row.invariant = get_pool_invariant( get_pool_reserves( row ), row.amplifier );
+        row.virtual_price = calculate_pool_virtual_price( row.reserves, row.liquidity.quantity );
+        row.trades += 1;
+        row.last_updated = current_time_point();
+
+        // swap log
+        curve::swaplog_action swaplog( get_self(), { get_self(), "active"_n });
+        CURVE_PROFILE_COUNT( swaplog, 1 );
+        swaplog.send( pool_id, owner, "swappool"_n, ext_in.quantity, ext_out.quantity, fee.quantity, price, row.reserves[index_in].quantity, row.reserves[index_out].quantity );
+    });
+    // accrue protocol fees (paid out by `claimfees`)
+    if ( protocol_fee.quantity.amount ) accrue_fee( protocol_fee );
+
+    // transfer amount to owner
+    transfer( get_self(), owner, ext_out, get_self().to_string() + ": swap token" );
+}
+
+void curve::add_pool_liquidity( const name owner, const symbol_code pool_id, const extended_asset value )
+{
+    curve::pools_table _pools( get_self(), get_self().value );
+    curve::poolorders_table _orders( get_self(), pool_id.raw() );
+
+    // get current order & pool
+    auto pool = _pools.get( pool_id.raw(), "curve::add_pool_liquidity: `pool_id` does not exist");
+    auto itr = _orders.find( owner.value );
+    const uint8_t index = get_pool_index( pool, value.quantity.symbol.code() );
+
+    // initialize quantities
+    auto insert = [&]( auto & row ) {
+        row.owner = owner;
+        if ( row.quantities.empty() ) {
+            for ( const extended_asset& reserve : pool.reserves ) row.quantities.push_back({ 0, reserve.get_extended_symbol() });
+        }
+
+        // add & validate deposit
+        check( row.quantities[index].get_extended_symbol() == value.get_extended_symbol(), "curve::add_pool_liquidity: invalid extended symbol");
+        row.quantities[index] += value;
+    };
+
+    // create/modify order
+    if ( itr == _orders.end() ) _orders.emplace( get_self(), insert );
+    else _orders.modify( itr, get_self(), insert );
+}
+
+void curve::deposit_pool( const name owner, const symbol_code pool_id, const optional<int64_t> min_amount )
+{
+    curve::pools_table _pools( get_self(), get_self().value );
+    curve::poolorders_table _orders( get_self(), pool_id.raw() );
+
+    // get current order & pool
+    auto & pool = _pools.get( pool_id.raw(), "curve::deposit: `pool_id` does not exist");
+    auto & orders = _orders.get( owner.value, "curve::deposit: no deposits available for this user");
+    const size_t size = pool.reserves.size();
+    const uint8_t precision_norm = pool.liquidity.quantity.symbol.precision();
+
+    // normalize reserves & deposits, if reserves empty, fallback to 1
+    vector<int128_t> reserves, amounts;
+    int128_t total_reserves = 0;
+    for ( size_t i = 0; i < size; i++ ) {
+        const symbol sym = pool.reserves[i].quantity.symbol;
+        check( orders.quantities[i].quantity.amount, "curve::deposit: one of the deposit is empty");
+        reserves.push_back( pool.reserves[i].quantity.amount ? mul_amount(pool.reserves[i].quantity.amount, precision_norm, sym.precision()) : 1 );
+        amounts.push_back( mul_amount(orders.quantities[i].quantity.amount, precision_norm, sym.precision()) );
+        total_reserves += reserves[i];
+    }
+
+    // reserves ratio should remain the same: deposits are limited by the smallest amount relative to its reserve
+    size_t k = 0;
+    for ( size_t i = 1; i < size; i++ ) {
+        if ( amounts[i] * reserves[k] < amounts[k] * reserves[i] ) k = i;
+    }
+
+    // calculate actual amounts to deposit & send back excess deposit to owner
+    vector<extended_asset> ext_deposits;
+    int128_t total_deposits = 0;
+    for ( size_t i = 0; i < size; i++ ) {
+        const symbol sym = pool.reserves[i].quantity.symbol;
+        const int128_t deposit = i == k ? amounts[k] : amounts[k] * reserves[i] / reserves[k];
+        total_deposits += deposit;
+
+        if ( deposit < amounts[i] ) {
+            const int64_t excess_amount = div_amount(static_cast<int64_t>(amounts[i] - deposit), precision_norm, sym.precision());
+            const extended_asset excess = { excess_amount, pool.reserves[i].get_extended_symbol() };
+            if ( excess.quantity.amount ) transfer( get_self(), owner, excess, get_self().to_string() + ": excess");
+        }
+        ext_deposits.push_back({ div_amount(static_cast<int64_t>(deposit), precision_norm, sym.precision()), pool.reserves[i].get_extended_symbol() });
+    }
+
+    // issue liquidity
+    const int64_t supply = pool.liquidity.quantity.amount;
+    const int64_t issued_amount = rex::issue(total_deposits, total_reserves, supply, 1);
+    const extended_asset issued = { issued_amount, pool.liquidity.get_extended_symbol() };
+
+    // add liquidity deposits & newly issued liquidity
+    _pools.modify(pool, get_self(), [&]( auto & row ) {
+        for ( size_t i = 0; i < size; i++ ) row.reserves[i] += ext_deposits[i];
+        row.liquidity += issued;
+        row.invariant = get_pool_invariant( get_pool_reserves( row ), row.amplifier );
+        row.virtual_price = calculate_pool_virtual_price( row.reserves, row.liquidity.quantity );
+    });
+
+    // issue & transfer to owner
+    issue( issued, get_self().to_string() + ": deposit" );
+    transfer( get_self(), owner, issued, get_self().to_string() + ": deposit");
+
+    // deposit slippage protection
+    if ( min_amount ) check( issued.quantity.amount >= *min_amount, "curve::deposit: deposit amount must exceed `min_amount`");
+
+    // delete any remaining liquidity deposit order
+    _orders.erase( orders );
+}
+
+void curve::cancel_pool( const name owner, const symbol_code pool_id )
+{
+    curve::poolorders_table _orders( get_self(), pool_id.raw() );
+    auto & orders = _orders.get( owner.value, "curve::cancel: no deposits for this user in this pool");
+    for ( const extended_asset& quantity : orders.quantities ) {
+        if ( quantity.quantity.amount ) transfer( get_self(), owner, quantity, get_self().to_string() + ": cancel");
+    }
+    _orders.erase( orders );
+}
+
+void curve::withdraw_pool_liquidity( const name owner, const extended_asset value )
+{
+    curve::pools_table _pools( get_self(), get_self().value );
+
+    // get current pool
+    const symbol_code pool_id = value.quantity.symbol.code();
+    auto & pool = _pools.get( pool_id.raw(), "curve::withdraw_pool_liquidity: `pool_id` does not exist");
+
+    // prevent invalid liquidity token contracts
+    check(pool.liquidity.get_extended_symbol() == value.get_extended_symbol(), "curve::withdraw_pool_liquidity: invalid extended symbol");
+
+    // calculate total deposits based on reserves
+    const size_t size = pool.reserves.size();
+    const uint8_t precision_norm = pool.liquidity.quantity.symbol.precision();
+    vector<int128_t> reserves;
+    int128_t total_reserves = 0;
+    for ( const extended_asset& reserve : pool.reserves ) {
+        reserves.push_back( reserve.quantity.amount ? mul_amount(reserve.quantity.amount, precision_norm, reserve.quantity.symbol.precision()) : 1 );
+        total_reserves += reserves.back();
+    }
+
+    // calculate withdraw amounts
+    const int64_t retire_amount = rex::retire( value.quantity.amount, total_reserves, pool.liquidity.quantity.amount );
+    vector<int64_t> amounts;
+    bool is_final = false;
+    for ( size_t i = 0; i < size; i++ ) {
+        amounts.push_back( static_cast<int64_t>( retire_amount * reserves[i] / total_reserves ) );
+        if ( amounts[i] == reserves[i] ) is_final = true;
+    }
+    //deal with rounding error on final withdrawal
+    if ( is_final ) {
+        for ( size_t i = 0; i < size; i++ ) amounts[i] = static_cast<int64_t>( reserves[i] );
+    }
+    vector<extended_asset> outs;
+    bool is_empty = true;
+    for ( size_t i = 0; i < size; i++ ) {
+        outs.push_back({ div_amount(amounts[i], precision_norm, pool.reserves[i].quantity.symbol.precision()), pool.reserves[i].get_extended_symbol() });
+        if ( outs[i].quantity.amount ) is_empty = false;
+    }
+    check( !is_empty, "curve::withdraw_pool_liquidity: withdraw amount too small");
+
+    // remove liquidity
+    _pools.modify(pool, get_self(), [&]( auto & row ) {
+        for ( size_t i = 0; i < size; i++ ) row.reserves[i] -= outs[i];
+        row.liquidity -= value;
+        row.invariant = get_pool_invariant( get_pool_reserves( row ), row.amplifier );
+        row.virtual_price = row.liquidity.quantity.amount ? calculate_pool_virtual_price( row.reserves, row.liquidity.quantity ) : 0;
+    });
+
+    // retire & transfer to owner
+    retire( value, get_self().to_string() + ": withdraw" );
+    for ( const extended_asset& out : outs ) {
+        if ( out.quantity.amount ) transfer( get_self(), owner, out, get_self().to_string() + ": withdraw");
+    }
+}
+
+// calculate reserve amounts relative to supply
+double curve::calculate_pool_virtual_price( const vector<extended_asset>& reserves, const asset supply )
+{
+    int64_t amount = 0;
+    for ( const extended_asset& reserve : reserves ) {
+        amount = safemath::add( amount, mul_amount( reserve.quantity.amount, supply.symbol.precision(), reserve.quantity.symbol.precision() ) );
+    }
+    return static_cast<double>( amount ) / supply.amount;
+}
+
+} // namespace sx
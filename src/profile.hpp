@@ -0,0 +1,202 @@
+#pragma once
+
+#include <eosio/eosio.hpp>
+#include <eosio/singleton.hpp>
+
+/**
+ * ## PROFILE `CURVE_PROFILE`
+ *
+ * Opt-in instrumentation build, counts per top-level action (action or `on_transfer` notification):
+ *
+ * - `find`, `get`, `emplace`, `modify`, `erase` - `multi_index` table operations
+ * - `config` - singleton reads (`config`, `notifiers`), `config_set` - singleton writes
+ * - `transfer`, `issue`, `retire`, `create`, `swaplog`, `routelog`, `liquiditylog` - inline actions sent
+ * - `recipient` - `require_recipient` calls
+ * - `d_it`, `y_it` - solver iterations (invariant D & reserve out)
+ * - `scale` - precision rescaling (`mul_amount` / `div_amount`)
+ *
+ * Counters are printed as one line when the action returns (nodeos `--contracts-console`)
+ * Without `-DCURVE_PROFILE` every counter compiles out and tables are plain `eosio::multi_index` / `eosio::singleton`
+ *
+ * ### example
+ *
+ * ```bash
+ * $ eosio-cpp curve.sx.cpp -o curve.sx.wasm -I include -DCURVE_PROFILE
+ * $ cleos transfer myaccount curve.sx "1.0000 A" "swap,0,AB-BC" --contract eosio.token
+ * # profile:on_transfer find=4 get=0 emplace=0 modify=2 erase=0 config=1 config_set=0 transfer=3 ...
+ * ```
+ */
+#ifdef CURVE_PROFILE
+
+#define CURVE_PROFILE_COUNT( counter, n ) ( sx::profile::current().counter += (n) )
+#define CURVE_PROFILE_SCOPE( action ) sx::profile::scope _profile_scope( action )
+
+namespace sx::profile {
+
+    struct counters {
+        uint32_t    find = 0;
+        uint32_t    get = 0;
+        uint32_t    emplace = 0;
+        uint32_t    modify = 0;
+        uint32_t    erase = 0;
+        uint32_t    config = 0;
+        uint32_t    config_set = 0;
+        uint32_t    transfer = 0;
+        uint32_t    issue = 0;
+        uint32_t    retire = 0;
+        uint32_t    create = 0;
+        uint32_t    swaplog = 0;
+        uint32_t    routelog = 0;
+        uint32_t    liquiditylog = 0;
+        uint32_t    recipient = 0;
+        uint32_t    d_iterations = 0;
+        uint32_t    y_iterations = 0;
+        uint32_t    scale = 0;
+    };
+
+    // every action runs in its own WASM instance, counters only live for one action
+    inline counters& current()
+    {
+        static counters _counters;
+        return _counters;
+    }
+
+    // resets the counters on entry, prints them when the action returns (aborted actions print nothing)
+    struct scope {
+        const char* action;
+
+        scope( const char* action ) : action( action ) { current() = counters{}; }
+
+        ~scope()
+        {
+            const counters& c = current();
+            eosio::print( "profile:", action,
+                " find=", c.find, " get=", c.get, " emplace=", c.emplace, " modify=", c.modify, " erase=", c.erase,
+                " config=", c.config, " config_set=", c.config_set,
+                " transfer=", c.transfer, " issue=", c.issue, " retire=", c.retire, " create=", c.create,
+                " swaplog=", c.swaplog, " routelog=", c.routelog, " liquiditylog=", c.liquiditylog,
+                " recipient=", c.recipient,
+                " d_it=", c.d_iterations, " y_it=", c.y_iterations, " scale=", c.scale, "\n" );
+        }
+    };
+
+    /**
+     * `eosio::multi_index` counting `find`, `get`, `emplace`, `modify` & `erase`
+     */
+    template<eosio::name::raw TableName, typename T, typename... Indices>
+    class multi_index : public eosio::multi_index<TableName, T, Indices...> {
+        using base = eosio::multi_index<TableName, T, Indices...>;
+
+    public:
+        using base::base;
+        using typename base::const_iterator;
+
+        const_iterator find( uint64_t primary ) const
+        {
+            CURVE_PROFILE_COUNT( find, 1 );
+            return base::find( primary );
+        }
+
+        const_iterator require_find( uint64_t primary, const char* error_msg = "unable to find key" ) const
+        {
+            CURVE_PROFILE_COUNT( find, 1 );
+            return base::require_find( primary, error_msg );
+        }
+
+        const T& get( uint64_t primary, const char* error_msg = "unable to find key" ) const
+        {
+            CURVE_PROFILE_COUNT( get, 1 );
+            return base::get( primary, error_msg );
+        }
+
+        template<typename Lambda>
+        const_iterator emplace( eosio::name payer, Lambda&& constructor )
+        {
+            CURVE_PROFILE_COUNT( emplace, 1 );
+            return base::emplace( payer, std::forward<Lambda>( constructor ) );
+        }
+
+        template<typename Lambda>
+        void modify( const_iterator itr, eosio::name payer, Lambda&& updater )
+        {
+            CURVE_PROFILE_COUNT( modify, 1 );
+            base::modify( itr, payer, std::forward<Lambda>( updater ) );
+        }
+
+        template<typename Lambda>
+        void modify( const T& obj, eosio::name payer, Lambda&& updater )
+        {
+            CURVE_PROFILE_COUNT( modify, 1 );
+            base::modify( obj, payer, std::forward<Lambda>( updater ) );
+        }
+
+        const_iterator erase( const_iterator itr )
+        {
+            CURVE_PROFILE_COUNT( erase, 1 );
+            return base::erase( itr );
+        }
+
+        void erase( const T& obj )
+        {
+            CURVE_PROFILE_COUNT( erase, 1 );
+            base::erase( obj );
+        }
+    };
+
+    /**
+     * `eosio::singleton` counting reads (`exists`, `get`, `get_or_default`) & writes (`set`, `remove`)
+     */
+    template<eosio::name::raw SingletonName, typename T>
+    class singleton : public eosio::singleton<SingletonName, T> {
+        using base = eosio::singleton<SingletonName, T>;
+
+    public:
+        using base::base;
+
+        bool exists()
+        {
+            CURVE_PROFILE_COUNT( config, 1 );
+            return base::exists();
+        }
+
+        T get()
+        {
+            CURVE_PROFILE_COUNT( config, 1 );
+            return base::get();
+        }
+
+        T get_or_default( const T& def = T() )
+        {
+            CURVE_PROFILE_COUNT( config, 1 );
+            return base::get_or_default( def );
+        }
+
+        void set( const T& value, eosio::name bill_to_account )
+        {
+            CURVE_PROFILE_COUNT( config_set, 1 );
+            base::set( value, bill_to_account );
+        }
+
+        void remove()
+        {
+            CURVE_PROFILE_COUNT( config_set, 1 );
+            base::remove();
+        }
+    };
+
+} // namespace sx::profile
+
+#else
+
+#define CURVE_PROFILE_COUNT( counter, n )
+#define CURVE_PROFILE_SCOPE( action )
+
+namespace sx::profile {
+    template<eosio::name::raw TableName, typename T, typename... Indices>
+    using multi_index = eosio::multi_index<TableName, T, Indices...>;
+
+    template<eosio::name::raw SingletonName, typename T>
+    using singleton = eosio::singleton<SingletonName, T>;
+}
+
+#endif
@@ -0,0 +1,68 @@
+namespace sx {
+
+// registers `pair_ids` swapped from `in` under `route_id`, validated & chained once (swap memo => "swap,<min_return>,@<route_id>")
+[[eosio::action]]
+void curve::addroute( const uint64_t route_id, const extended_symbol in, const vector<symbol_code> pair_ids )
+{
+    CURVE_PROFILE_SCOPE( "addroute" );
+    require_auth( get_self() );
+
+    curve::routes_table _routes( get_self(), get_self().value );
+    curve::pairs_table _pairs( get_self(), get_self().value );
+    check( _routes.find( route_id ) == _routes.end(), "curve::addroute: `route_id` already exists");
+    check( pair_ids.size() >= 1 && pair_ids.size() <= MAX_PAIR_IDS, "curve::addroute: invalid `pair_ids` size");
+
+    // chain extended symbols across the hops (checked by `apply_trade` on every swap of memo `pair_ids`)
+    extended_symbol out = in;
+    for ( auto itr = pair_ids.begin(); itr != pair_ids.end(); ++itr ) {
+        const auto& pair = _pairs.get( itr->raw(), "curve::addroute: `pair_id` does not exist");
+        check( std::find( pair_ids.begin(), itr, *itr ) == itr, "curve::addroute: invalid duplicate `pair_ids`");
+
+        const extended_symbol reserve0 = pair.reserve0.get_extended_symbol();
+        const extended_symbol reserve1 = pair.reserve1.get_extended_symbol();
+        check( reserve0 == out || reserve1 == out, "curve::addroute: invalid extended symbol");
+        out = reserve0 == out ? reserve1 : reserve0;
+    }
+
+    _routes.emplace( get_self(), [&]( auto & row ) {
+        row.route_id = route_id;
+        row.pair_ids = pair_ids;
+        row.in = in;
+        row.out = out;
+    });
+}
+
+[[eosio::action]]
+void curve::delroute( const uint64_t route_id )
+{
+    CURVE_PROFILE_SCOPE( "delroute" );
+    require_auth( get_self() );
+
+    curve::routes_table _routes( get_self(), get_self().value );
+    const auto& route = _routes.get( route_id, "curve::delroute: `route_id` does not exist");
+    _routes.erase( route );
+}
+
+// Memo schemas
+// ============
+// Registered route: `@<route_id>` (ex: "@1")
+// pairs are only found (`removepair` rejects pairs of registered routes), no tokens, symbol codes or duplicates to check
+curve::pair_ids_vector curve::parse_memo_route( context& ctx, const string_view memo )
+{
+    const int64_t route_id = sx::utils::parse_digits( memo );
+    check( route_id >= 0, ERROR_INVALID_MEMO );
+
+    curve::routes_table _routes( get_self(), get_self().value );
+    const auto& route = _routes.get( route_id, "curve::parse_memo_route: `route_id` does not exist");
+
+    pair_ids_vector pair_ids;
+    for ( const symbol_code pair_id : route.pair_ids ) {
+        pair_ids.push_back( pair_id );
+        ctx.route.push_back( ctx.pairs.find( pair_id.raw() ) );
+    }
+    ctx.route_in = route.in;
+    ctx.route_out = route.out;
+    return pair_ids;
+}
+
+} // namespace sx
@@ -8,5 +8,6 @@ bats ./__tests__/formula.bats
 bats ./__tests__/create_pairs.bats
 bats ./__tests__/liquidity.bats
 bats ./__tests__/swaps.bats
+bats ./__tests__/pools.bats
 bats ./__tests__/ramp.bats
 bats ./__tests__/withdraw.bats
\ No newline at end of file